@@ -0,0 +1,103 @@
+/****************************************************************************
+ * Copyright (c) 2018 by the Cabana authors                                 *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cabana_Core.hpp>
+#include <Cabana_Sort.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <iostream>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+// Time a sort function over a number of runs and return the average in ms.
+template<class SortFunction>
+double timeSort( const SortFunction& sort_function, const int num_run )
+{
+    std::vector<double> times( num_run );
+    for ( int t = 0; t < num_run; ++t )
+    {
+        auto start_time = std::chrono::high_resolution_clock::now();
+        sort_function();
+        auto end_time = std::chrono::high_resolution_clock::now();
+        auto elapsed_time = end_time - start_time;
+        times[t] = std::chrono::duration_cast<std::chrono::microseconds>(
+            elapsed_time).count() / 1000.0;
+    }
+
+    double avg = 0.0;
+    for ( auto& t : times ) avg += t;
+    return avg / num_run;
+}
+
+// Performance test function.
+void perfTest( const std::size_t num_data )
+{
+    using MemorySpace = Cabana::HostSpace;
+    using KokkosMemorySpace = MemorySpace::kokkos_memory_space;
+    using KeyViewType = Kokkos::View<std::int64_t*,KokkosMemorySpace>;
+
+    std::cout << std::endl;
+    std::cout << "Number of keys: " << num_data << std::endl;
+    std::cout << std::endl;
+
+    // Create keys with skewed distributions: uniform 64-bit global ids and
+    // cell hashes where most keys fall into few cells.
+    std::mt19937_64 generator( 1234 );
+    std::uniform_int_distribution<std::int64_t> uniform_dist;
+    std::geometric_distribution<std::int64_t> cell_dist( 0.01 );
+    KeyViewType uniform_keys( "uniform_keys", num_data );
+    KeyViewType cell_keys( "cell_keys", num_data );
+    for ( std::size_t i = 0; i < num_data; ++i )
+    {
+        uniform_keys( i ) = uniform_dist( generator );
+        cell_keys( i ) = cell_dist( generator ) * 1000003;
+    }
+
+    int num_run = 10;
+    int nbin = num_data / 2;
+    auto run = [&]( const std::string& name, KeyViewType keys )
+    {
+        double bin_time = timeSort(
+            [&](){ Cabana::Impl::kokkosBinSort1d( keys, nbin, true, 0, num_data ); },
+            num_run );
+        double radix_time = timeSort(
+            [&](){ Cabana::sortByKey( keys ); },
+            num_run );
+        std::cout << name << " keys" << std::endl;
+        std::cout << "  BinSort average run time: " << bin_time << "ms"
+                  << std::endl;
+        std::cout << "  Radix sort average run time: " << radix_time << "ms"
+                  << std::endl;
+    };
+    run( "Uniform", uniform_keys );
+    run( "Cell hash", cell_keys );
+    std::cout << std::endl;
+}
+
+int main( int argc, char* argv[] )
+{
+    // Number of keys.
+    std::size_t num_data = ( argc > 1 ) ? std::atoi( argv[1] ) : 1000000;
+
+    // Initialize the kokkos runtime.
+    Cabana::initialize( argc, argv );
+
+    // Run the test.
+    perfTest( num_data );
+
+    // Finalize.
+    Cabana::finalize();
+    return 0;
+}
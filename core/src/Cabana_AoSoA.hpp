@@ -24,8 +24,11 @@
 #include <Kokkos_Core.hpp>
 
 #include <type_traits>
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <cstdlib>
+#include <stdexcept>
 #include <string>
 
 namespace Cabana
@@ -55,31 +58,46 @@ namespace Cabana
   \endcode
   would define an AoSoA where each tuple had a 3x3 matrix of doubles, a
   3-vector of doubles, and an integer. The AoSoA is then templated on this
-  sequence of types. In general, put larger datatypes first in the
-  MemberType parameter pack (i.e. matrices and vectors) and group members
-  of the same type together to achieve the smallest possible memory footprint
-  based on compiler-generated padding.
+  sequence of types. The member arrays are ordered within the structs by
+  decreasing alignment to achieve the smallest possible memory footprint so
+  the order of the member types does not affect the padding. Members are
+  always accessed by their index in this sequence.
 
   \tparam MemorySpace (required) The memory space.
 
   \tparam VectorLength (optional) The vector length within the structs of
   the AoSoA. If not specified, this defaults to the preferred layout for the
   <tt>MemorySpace</tt>.
+
+  \tparam Alignment (optional) The alignment in bytes of the array of each
+  member within the structs. The structs are padded such that every member
+  array starts on a boundary of this alignment. If the alignment is at least
+  the Kokkos memory alignment then slices of the AoSoA are marked as aligned
+  so that vectorized loops over the arrays may use aligned loads and
+  stores. If not specified, or 0, the natural alignment of each member array
+  is used.
  */
 template<class DataTypes,
          class MemorySpace,
          int VectorLength = Impl::PerformanceTraits<
              typename MemorySpace::kokkos_execution_space>::vector_length,
+         int Alignment = 0,
          typename std::enable_if<
              (is_member_types<DataTypes>::value &&
               is_memory_space<MemorySpace>::value &&
-              Impl::IsVectorLengthValid<VectorLength>::value),int>::type = 0>
+              Impl::IsVectorLengthValid<VectorLength>::value &&
+              Impl::IsAlignmentValid<Alignment>::value),int>::type = 0>
 class AoSoA
 {
   public:
 
+    // Member arrays are only aligned within the allocation so the alignment
+    // may not exceed that of the allocation.
+    static_assert( Alignment <= int(Kokkos::Impl::MEMORY_ALIGNMENT),
+                   "AoSoA alignment may not exceed the Kokkos memory alignment" );
+
     // AoSoA type.
-    using aosoa_type = AoSoA<DataTypes,MemorySpace,VectorLength>;
+    using aosoa_type = AoSoA<DataTypes,MemorySpace,VectorLength,Alignment>;
 
     // Member data types.
     using member_types = DataTypes;
@@ -90,8 +108,22 @@ class AoSoA
     // Vector length (size of the arrays held by the structs).
     static constexpr int vector_length = VectorLength;
 
+    // Alignment of the struct member arrays in bytes.
+    static constexpr int alignment = Alignment;
+
     // SoA type.
-    using soa_type = SoA<member_types,vector_length>;
+    using soa_type = SoA<member_types,vector_length,alignment>;
+
+    // Number of bytes of member data in each struct.
+    static constexpr std::size_t struct_data_bytes = soa_type::data_bytes;
+
+    // Number of bytes of padding in each struct.
+    static constexpr std::size_t struct_padding_bytes =
+        sizeof(soa_type) - soa_type::data_bytes;
+
+    // Average number of bytes of storage per tuple including padding.
+    static constexpr double bytes_per_tuple =
+        double(sizeof(soa_type)) / vector_length;
 
     // Managed data view.
     using soa_view =
@@ -111,9 +143,18 @@ class AoSoA
 
     // Member data type at a given index M. Note this is the user-defined
     // member data type - not the potentially transformed type actually stored
-    // by the structs (SoAs) to achieve a given layout.
+    // by the structs (SoAs) to achieve a given layout. For members declared
+    // with the Stored adapter this is the storage type.
+    template<std::size_t M>
+    using member_data_type = typename MemberDataType<
+        typename MemberTypeAtIndex<M,member_types>::type>::type;
+
+    // Member slice data type at a given index M. This is the member type as
+    // declared by the user such that slices of Stored members convert values
+    // between the storage and compute types.
     template<std::size_t M>
-    using member_data_type = typename MemberTypeAtIndex<M,member_types>::type;
+    using member_slice_data_type =
+        typename MemberTypeAtIndex<M,member_types>::type;
 
     // Struct member array element value type at a given index M.
     template<std::size_t M>
@@ -136,6 +177,8 @@ class AoSoA
         : _size( 0 )
         , _capacity( 0 )
         , _num_soa( 0 )
+        , _growth_factor( 1.5 )
+        , _managed( true )
     {}
 
     /*!
@@ -147,10 +190,87 @@ class AoSoA
         : _size( n )
         , _capacity( 0 )
         , _num_soa( 0 )
+        , _growth_factor( 1.5 )
+        , _managed( true )
     {
         resize( _size );
     }
 
+    /*!
+      \brief Allocate a container with n tuples without initializing them.
+
+      \param tag Tag indicating the memory should not be initialized.
+
+      \param n The number of tuples in the container.
+
+      The tuples in the container have unspecified values until they are
+      assigned.
+    */
+    AoSoA( WithoutInitializing_t tag, const int n )
+        : _size( n )
+        , _capacity( 0 )
+        , _num_soa( 0 )
+        , _growth_factor( 1.5 )
+        , _managed( true )
+    {
+        resize( tag, _size );
+    }
+
+    /*!
+      \brief Wrap externally owned memory in a container without copying it.
+
+      \param data Pointer to the first struct. The memory must be in the
+      memory space of the container and be laid out as the structs of this
+      container, i.e. as blocks of soa_type, and be aligned to them.
+
+      \param n The number of tuples in the container.
+
+      \param bytes The number of bytes available at the pointer. The capacity
+      of the container is the number of whole structs in these bytes.
+
+      \param data_vector_length The vector length of the external data which
+      must be the vector length of the container.
+
+      The container does not own the memory and never reallocates it such
+      that resizing or reserving beyond the capacity throws. The memory must
+      outlive the container and all of its shallow copies.
+    */
+    AoSoA( void* data,
+           const std::size_t n,
+           const std::size_t bytes,
+           const int data_vector_length )
+        : _size( n )
+        , _capacity( 0 )
+        , _num_soa( 0 )
+        , _growth_factor( 1.5 )
+        , _managed( false )
+    {
+        if ( vector_length != data_vector_length )
+            throw std::runtime_error(
+                "Unmanaged AoSoA data has a different vector length" );
+        if ( nullptr == data && 0 < bytes )
+            throw std::runtime_error( "Unmanaged AoSoA data is null" );
+        if ( 0 != reinterpret_cast<std::uintptr_t>(data) % alignof(soa_type) )
+            throw std::runtime_error(
+                "Unmanaged AoSoA data is not aligned to the structs" );
+        if ( 0 != bytes % sizeof(soa_type) )
+            throw std::runtime_error(
+                "Unmanaged AoSoA data size is not a multiple of the struct size" );
+
+        std::size_t num_soa = bytes / sizeof(soa_type);
+        if ( n > num_soa * vector_length )
+            throw std::runtime_error(
+                "Unmanaged AoSoA size exceeds the size of the data" );
+
+        _capacity = num_soa * vector_length;
+        _data = ( 0 < num_soa )
+                ? soa_view( static_cast<soa_type*>(data), num_soa )
+                : soa_view();
+        storePointersAndStrides(
+            std::integral_constant<std::size_t,number_of_members-1>() );
+        resize( n );
+    }
+
     /*!
       \brief Returns the number of tuples in the container.
 
@@ -182,6 +302,13 @@ class AoSoA
     CABANA_FUNCTION
     std::size_t capacity() const { return _capacity; }
 
+    /*!
+      \brief Whether the container owns its memory.
+
+      \return False if the container wraps externally owned memory.
+    */
+    bool isManaged() const { return _managed; }
+
     /*!
       \brief Resizes the container so that it contains n tuples.
 
@@ -192,21 +319,34 @@ class AoSoA
       by inserting at the end as many tuples as needed to reach a size of n.
 
       If n is also greater than the current container capacity, an automatic
-      reallocation of the allocated storage space takes place.
+      reallocation of the allocated storage space takes place. The new
+      capacity is the larger of n and the current capacity scaled by the
+      growth factor such that repeated calls to resize with a slowly
+      increasing size only reallocate a logarithmic number of times.
 
       Notice that this function changes the actual content of the container by
       inserting or erasing tuples from it.
     */
     void resize( const std::size_t n )
     {
-        // Reserve memory if needed.
-        reserve( n );
+        resizeImpl( n, true );
+    }
 
-        // Update the sizes of the data. This is potentially different than
-        // the amount of allocated data.
-        _size = n;
-        _num_soa = std::floor( n / vector_length );
-        if ( 0 < n % vector_length ) ++_num_soa;
+    /*!
+      \brief Resizes the container so that it contains n tuples without
+      initializing new memory.
+
+      \param tag Tag indicating new memory should not be initialized.
+
+      \param n The new number of tuples in the container.
+
+      Behaves as resize(n) except that if a reallocation takes place the new
+      storage is not initialized. Existing tuples are preserved while any
+      tuples added by this call have unspecified values.
+    */
+    void resize( WithoutInitializing_t, const std::size_t n )
+    {
+        resizeImpl( n, false );
     }
 
     /*!
@@ -225,28 +365,68 @@ class AoSoA
     */
     void reserve( const std::size_t n )
     {
-        // If we aren't asking for more memory then we have nothing to do.
-        if ( n <= _capacity ) return;
+        reserveImpl( n, true );
+    }
 
-        // Figure out the new capacity.
-        std::size_t num_soa_alloc = std::floor( n / vector_length );
-        if ( 0 < n % vector_length ) ++num_soa_alloc;
+    /*!
+      \brief Requests that the container capacity be at least enough to contain n
+      tuples without initializing new memory.
 
-        // If we aren't asking for any more SoA objects then we still have
-        // nothing to do.
-        if ( num_soa_alloc <= _num_soa ) return;
+      \param tag Tag indicating new memory should not be initialized.
 
-        // Assign the new capacity.
-        _capacity = num_soa_alloc * vector_length;
+      \param n The number of tuples to reserve space for.
 
-        // If we need more SoA objects then resize.
-        Kokkos::resize( _data, num_soa_alloc );
+      Behaves as reserve(n) except that if a reallocation takes place only the
+      existing tuples are copied to the new storage and the remaining storage
+      is not initialized.
+    */
+    void reserve( WithoutInitializing_t, const std::size_t n )
+    {
+        reserveImpl( n, false );
+    }
 
-        // Get new pointers and strides for the members.
-        storePointersAndStrides(
-            std::integral_constant<std::size_t,number_of_members-1>() );
+    /*!
+      \brief Reduce the capacity of the container to fit its size.
+
+      The container storage is reallocated to the smallest number of
+      structs-of-arrays that will hold the current tuples. If the container
+      is empty all of its memory is released. Existing tuples are preserved.
+
+      This function has no effect on the container size and is typically used
+      to reclaim memory after a large number of tuples have been removed. It
+      has no effect on containers wrapping unmanaged memory.
+    */
+    void shrinkToFit()
+    {
+        if ( _managed && _num_soa * vector_length < _capacity )
+            reallocate( _num_soa, false );
     }
 
+    /*!
+      \brief Set the factor by which the capacity grows when resize requires
+      a reallocation.
+
+      \param factor The capacity growth factor. Must be at least 1. A factor
+      of 1 allocates exactly the requested number of tuples (rounded up to a
+      whole number of structs-of-arrays).
+
+      Explicit calls to reserve are not affected by the growth factor.
+    */
+    void setGrowthFactor( const double factor )
+    {
+        if ( !(factor >= 1.0) )
+            throw std::runtime_error( "AoSoA growth factor must be >= 1" );
+        _growth_factor = factor;
+    }
+
+    /*!
+      \brief Get the factor by which the capacity grows when resize requires
+      a reallocation.
+
+      \return The capacity growth factor.
+    */
+    double growthFactor() const { return _growth_factor; }
+
     /*!
       \brief Get the number of structs-of-arrays in the container.
 
@@ -325,18 +505,34 @@ class AoSoA
       \return The member slice.
     */
     template<std::size_t M>
-    Slice<member_data_type<M>,memory_space,DefaultAccessMemory,vector_length>
+    Slice<member_slice_data_type<M>,memory_space,DefaultAccessMemory,
+          vector_length,alignment>
     slice() const
     {
         return
-            Slice<member_data_type<M>,
+            Slice<member_slice_data_type<M>,
                   memory_space,
                   DefaultAccessMemory,
-                  vector_length>(
+                  vector_length,
+                  alignment>(
                       (member_pointer_type<M>) _pointers[M],
                       _size, _strides[M], _num_soa );
     }
 
+    /*!
+      \brief Get an unmanaged read-only slice of a tuple member with default
+      memory access. Read-only slices may alias other slices of the member.
+      \tparam M The member index to get a slice of.
+      \return The read-only member slice.
+    */
+    template<std::size_t M>
+    Slice<const member_slice_data_type<M>,memory_space,DefaultAccessMemory,
+          vector_length,alignment>
+    constSlice() const
+    {
+        return slice<M>();
+    }
+
     /*!
       \brief Get an un-typed raw pointer to the entire data block.
       \return An un-typed raw-pointer to the entire data block.
@@ -346,13 +542,99 @@ class AoSoA
 
   private:
 
+    // Resize implementation. Optionally initialize new memory.
+    void resizeImpl( const std::size_t n, const bool initialize )
+    {
+        // Reserve memory if needed. Grow geometrically so that the cost of
+        // reallocation is amortized over many insertions.
+        if ( n > _capacity )
+        {
+            std::size_t num_soa_grow =
+                std::ceil( _growth_factor * _capacity / vector_length );
+            reserveImpl( std::max( n, num_soa_grow * vector_length ),
+                         initialize );
+        }
+
+        // Update the sizes of the data. This is potentially different than
+        // the amount of allocated data.
+        _size = n;
+        _num_soa = std::floor( n / vector_length );
+        if ( 0 < n % vector_length ) ++_num_soa;
+    }
+
+    // Reserve implementation. Optionally initialize new memory.
+    void reserveImpl( const std::size_t n, const bool initialize )
+    {
+        // If we aren't asking for more memory then we have nothing to do.
+        if ( n <= _capacity ) return;
+
+        // Figure out the new capacity.
+        std::size_t num_soa_alloc = std::floor( n / vector_length );
+        if ( 0 < n % vector_length ) ++num_soa_alloc;
+
+        // If we aren't asking for any more SoA objects then we still have
+        // nothing to do.
+        if ( num_soa_alloc <= _num_soa ) return;
+
+        // If we need more SoA objects then resize.
+        reallocate( num_soa_alloc, initialize );
+    }
+
+    // Reallocate the data to hold the given number of SoA objects, preserving
+    // the contents of the SoA objects in use that fit in the new
+    // allocation. If the new memory is not initialized then only the SoA
+    // objects in use are copied.
+    void reallocate( const std::size_t num_soa_alloc, const bool initialize )
+    {
+        // Unmanaged memory cannot be reallocated.
+        if ( !_managed )
+            throw std::runtime_error(
+                "Attempted to reallocate an unmanaged AoSoA" );
+
+        // Assign the new capacity.
+        _capacity = num_soa_alloc * vector_length;
+
+        // Resize the data. Release everything if we don't need any data.
+        if ( 0 == num_soa_alloc )
+        {
+            _data = soa_view();
+        }
+        else if ( initialize )
+        {
+            Kokkos::resize( _data, num_soa_alloc );
+        }
+        else
+        {
+            soa_view new_data(
+                Kokkos::ViewAllocateWithoutInitializing(_data.label()),
+                num_soa_alloc );
+            std::size_t num_soa_copy = std::min( _num_soa, num_soa_alloc );
+            if ( 0 < num_soa_copy )
+            {
+                using kokkos_memory_space =
+                    typename memory_space::kokkos_memory_space;
+                Kokkos::fence();
+                Kokkos::Impl::DeepCopy<kokkos_memory_space,kokkos_memory_space>(
+                    new_data.data(), _data.data(),
+                    num_soa_copy * sizeof(soa_type) );
+                Kokkos::fence();
+            }
+            _data = new_data;
+        }
+
+        // Get new pointers and strides for the members.
+        storePointersAndStrides(
+            std::integral_constant<std::size_t,number_of_members-1>() );
+    }
+
     // Store the pointers and strides for each member element.
     template<std::size_t N>
     void assignPointersAndStrides()
     {
         static_assert( 0 <= N && N < number_of_members,
                        "Static loop out of bounds!" );
-        _pointers[N] = _data(0).template ptr<N>();
+        _pointers[N] = ( 0 < _data.extent(0) )
+                       ? _data(0).template ptr<N>() : nullptr;
         static_assert( 0 ==
                        sizeof(soa_type) % sizeof(member_value_type<N>),
                        "Stride cannot be calculated for misaligned memory!" );
@@ -383,6 +665,14 @@ class AoSoA
     // Number of structs-of-arrays in the array.
     std::size_t _num_soa;
 
+    // Factor by which the capacity grows when resizing requires a
+    // reallocation.
+    double _growth_factor;
+
+    // Whether the container owns its memory. Unmanaged containers wrap
+    // external memory which is never reallocated.
+    bool _managed;
+
     // Structs-of-Arrays managed data. This Kokkos View manages the block of
     // memory owned by this class such that the copy constructor and
     // assignment operator for this class perform a shallow and reference
@@ -402,12 +692,12 @@ class AoSoA
 template<class >
 struct is_aosoa : public std::false_type {};
 
-template<class DataTypes, class MemorySpace, int VectorLength>
-struct is_aosoa<AoSoA<DataTypes,MemorySpace,VectorLength> >
+template<class DataTypes, class MemorySpace, int VectorLength, int Alignment>
+struct is_aosoa<AoSoA<DataTypes,MemorySpace,VectorLength,Alignment> >
     : public std::true_type {};
 
-template<class DataTypes, class MemorySpace, int VectorLength>
-struct is_aosoa<const AoSoA<DataTypes,MemorySpace,VectorLength> >
+template<class DataTypes, class MemorySpace, int VectorLength, int Alignment>
+struct is_aosoa<const AoSoA<DataTypes,MemorySpace,VectorLength,Alignment> >
     : public std::true_type {};
 
 //---------------------------------------------------------------------------//
@@ -0,0 +1,136 @@
+/****************************************************************************
+ * Copyright (c) 2018 by the Cabana authors                                 *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef CABANA_APPEND_HPP
+#define CABANA_APPEND_HPP
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_DeepCopy.hpp>
+#include <Cabana_SoA.hpp>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_ExecPolicy.hpp>
+
+#include <type_traits>
+#include <exception>
+
+namespace Cabana
+{
+//---------------------------------------------------------------------------//
+/*!
+  \brief Append a range of tuples from one AoSoA to the end of another.
+
+  \param dst The AoSoA to append to.
+
+  \param src The AoSoA to append from.
+
+  \param begin The beginning index of the source range to append.
+
+  \param end The ending index of the source range to append.
+
+  The destination is resized once to hold the new tuples and the tuples are
+  then copied in parallel. Both AoSoA objects must have the same member types
+  and memory space but may have different vector lengths. If the vector
+  lengths are the same and both the end of the destination and the beginning
+  of the source range fall on a struct boundary then whole structs are copied
+  byte-wise. Otherwise runs of tuples which are contiguous in both layouts
+  are copied per member.
+*/
+template<class DstAoSoA, class SrcAoSoA>
+void append(
+    DstAoSoA& dst,
+    const SrcAoSoA& src,
+    const std::size_t begin,
+    const std::size_t end,
+    typename std::enable_if<(is_aosoa<DstAoSoA>::value &&
+                             is_aosoa<SrcAoSoA>::value)>::type * = 0 )
+{
+    using dst_type = DstAoSoA;
+    using src_type = SrcAoSoA;
+    using kokkos_memory_space =
+        typename dst_type::memory_space::kokkos_memory_space;
+    using dst_index = typename dst_type::index_type;
+    using src_index = typename src_type::index_type;
+    using dst_soa_type = typename dst_type::soa_type;
+    using src_soa_type = typename src_type::soa_type;
+
+    // Check that the data types are the same.
+    static_assert(
+        std::is_same<typename dst_type::member_types,
+        typename src_type::member_types>::value,
+        "Attempted to append AoSoA objects of different member types" );
+
+    // Check that the memory spaces are the same.
+    static_assert(
+        std::is_same<typename dst_type::memory_space,
+        typename src_type::memory_space>::value,
+        "Attempted to append AoSoA objects in different memory spaces" );
+
+    // Check the range.
+    if ( end < begin || src.size() < end )
+        throw std::runtime_error( "Invalid source range for AoSoA append" );
+
+    // Nothing to do for an empty range.
+    std::size_t num_append = end - begin;
+    if ( 0 == num_append ) return;
+
+    // Grow the destination once.
+    std::size_t dst_begin = dst.size();
+    dst.resize( dst_begin + num_append );
+
+    // If the layouts match and both ranges start on a struct boundary then
+    // copy whole structs. The last struct may contain more source data than
+    // requested but it is copied into the unused portion of the destination.
+    if ( std::is_same<dst_soa_type,src_soa_type>::value &&
+         0 == dst_index::a(dst_begin) &&
+         0 == src_index::a(begin) )
+    {
+        std::size_t num_soa = src_index::s( num_append );
+        if ( 0 < src_index::a( num_append ) ) ++num_soa;
+        Kokkos::fence();
+        Kokkos::Impl::DeepCopy<kokkos_memory_space,kokkos_memory_space>(
+            &dst.access( dst_index::s(dst_begin) ),
+            &src.access( src_index::s(begin) ),
+            num_soa * sizeof(src_soa_type) );
+        Kokkos::fence();
+    }
+
+    // Otherwise copy the runs of tuples which are contiguous in both the
+    // source and destination structs.
+    else
+    {
+        Impl::kernelRangeCopy( dst, dst_begin, src, begin, num_append );
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Append all tuples from one AoSoA to the end of another.
+
+  \param dst The AoSoA to append to.
+
+  \param src The AoSoA to append from.
+*/
+template<class DstAoSoA, class SrcAoSoA>
+void append(
+    DstAoSoA& dst,
+    const SrcAoSoA& src,
+    typename std::enable_if<(is_aosoa<DstAoSoA>::value &&
+                             is_aosoa<SrcAoSoA>::value)>::type * = 0 )
+{
+    append( dst, src, 0, src.size() );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Cabana
+
+#endif // end CABANA_APPEND_HPP
@@ -0,0 +1,332 @@
+/****************************************************************************
+ * Copyright (c) 2018 by the Cabana authors                                 *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef CABANA_CHECKPOINT_HPP
+#define CABANA_CHECKPOINT_HPP
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_DeepCopy.hpp>
+#include <Cabana_Types.hpp>
+#include <impl/Cabana_CheckpointFormat.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace Cabana
+{
+namespace Impl
+{
+//---------------------------------------------------------------------------//
+// A binary file which throws on failed reads and writes.
+class CheckpointFile
+{
+  public:
+
+    CheckpointFile( const std::string& filename, const char* mode )
+        : _file( std::fopen(filename.c_str(),mode) )
+    {
+        if ( nullptr == _file )
+            throw std::runtime_error( "Failed to open checkpoint file " +
+                                      filename );
+    }
+
+    ~CheckpointFile()
+    {
+        if ( nullptr != _file ) std::fclose( _file );
+    }
+
+    CheckpointFile( const CheckpointFile& ) = delete;
+    CheckpointFile& operator=( const CheckpointFile& ) = delete;
+
+    void write( const void* data, const std::size_t bytes )
+    {
+        if ( bytes != std::fwrite(data,1,bytes,_file) )
+            throw std::runtime_error( "Failed to write checkpoint file" );
+    }
+
+    void read( void* data, const std::size_t bytes )
+    {
+        if ( bytes != std::fread(data,1,bytes,_file) )
+            throw std::runtime_error( "Failed to read checkpoint file" );
+    }
+
+    void seek( const std::size_t offset )
+    {
+        if ( 0 != std::fseek(_file,offset,SEEK_SET) )
+            throw std::runtime_error( "Failed to seek in checkpoint file" );
+    }
+
+    void close()
+    {
+        int status = std::fclose( _file );
+        _file = nullptr;
+        if ( 0 != status )
+            throw std::runtime_error( "Failed to close checkpoint file" );
+    }
+
+  private:
+
+    std::FILE* _file;
+};
+
+//---------------------------------------------------------------------------//
+// Read structs written with a different layout and re-block them into the
+// given host memory with the layout of the destination. The source structs
+// are read in chunks bounded by the deep copy staging size.
+inline void reblockCheckpoint( CheckpointFile& file,
+                               const CheckpointHeader& header,
+                               const std::vector<CheckpointMember>& src_members,
+                               const std::vector<CheckpointMember>& dst_members,
+                               char* dst_data,
+                               const std::size_t dst_soa_bytes,
+                               const std::size_t dst_vector_length )
+{
+    std::size_t src_soa_bytes = header.soa_bytes;
+    std::size_t src_vector_length = header.vector_length;
+    std::size_t chunk_num_soa =
+        std::max( deepCopyStagingBytes() / src_soa_bytes, std::size_t(1) );
+    std::vector<char> buffer(
+        std::min(chunk_num_soa,std::size_t(header.num_soa)) * src_soa_bytes );
+
+    for ( std::size_t s0 = 0; s0 < header.num_soa; s0 += chunk_num_soa )
+    {
+        std::size_t num_soa =
+            std::min( chunk_num_soa, std::size_t(header.num_soa) - s0 );
+        file.read( buffer.data(), num_soa * src_soa_bytes );
+
+        // Copy runs of tuples which are contiguous in both layouts.
+        std::size_t end = std::min( (s0 + num_soa) * src_vector_length,
+                                    std::size_t(header.size) );
+        std::size_t i = s0 * src_vector_length;
+        while ( i < end )
+        {
+            std::size_t src_s = i / src_vector_length - s0;
+            std::size_t src_a = i % src_vector_length;
+            std::size_t dst_s = i / dst_vector_length;
+            std::size_t dst_a = i % dst_vector_length;
+            std::size_t run = std::min( std::min(src_vector_length - src_a,
+                                                 dst_vector_length - dst_a),
+                                        end - i );
+
+            for ( std::size_t m = 0; m < dst_members.size(); ++m )
+            {
+                std::size_t value_bytes = dst_members[m].value_bytes;
+                std::size_t num_comp =
+                    checkpointMemberComponents( dst_members[m] );
+                for ( std::size_t c = 0; c < num_comp; ++c )
+                {
+                    std::memcpy(
+                        dst_data + dst_s * dst_soa_bytes +
+                        dst_members[m].offset +
+                        (c * dst_vector_length + dst_a) * value_bytes,
+                        buffer.data() + src_s * src_soa_bytes +
+                        src_members[m].offset +
+                        (c * src_vector_length + src_a) * value_bytes,
+                        run * value_bytes );
+                }
+            }
+
+            i += run;
+        }
+    }
+}
+
+//---------------------------------------------------------------------------//
+// Write the header and member descriptions of an AoSoA padded to the
+// offset of its structs.
+template<class AoSoA_t>
+void writeCheckpointHeader( CheckpointFile& file, const AoSoA_t& aosoa )
+{
+    CheckpointHeader header =
+        checkpointHeader<AoSoA_t>( aosoa.size(), aosoa.numSoA() );
+    std::vector<CheckpointMember> members = checkpointMembers<AoSoA_t>();
+    std::size_t bytes =
+        sizeof(header) + members.size() * sizeof(CheckpointMember);
+    std::vector<char> padding( header.data_offset - bytes, 0 );
+
+    file.write( &header, sizeof(header) );
+    file.write( members.data(), members.size() * sizeof(CheckpointMember) );
+    file.write( padding.data(), padding.size() );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Impl
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Write an AoSoA to a binary checkpoint file.
+
+  \param filename The file to write.
+
+  \param aosoa The AoSoA to write.
+
+  The file contains a small header describing the member types, vector
+  length, and size of the AoSoA followed by the structs of the AoSoA written
+  as a single block without reformatting. Data in memory which is not host
+  accessible is staged through a host buffer in chunks of at most the deep
+  copy staging size.
+*/
+template<class AoSoA_t>
+void write( const std::string& filename,
+            const AoSoA_t& aosoa,
+            typename std::enable_if<is_aosoa<AoSoA_t>::value,int>::type * = 0 )
+{
+    using soa_type = typename AoSoA_t::soa_type;
+    using kokkos_memory_space =
+        typename AoSoA_t::memory_space::kokkos_memory_space;
+
+    Impl::CheckpointFile file( filename, "wb" );
+    Impl::writeCheckpointHeader( file, aosoa );
+
+    std::size_t bytes = aosoa.numSoA() * sizeof(soa_type);
+    const char* data = static_cast<const char*>( aosoa.ptr() );
+
+    // Write host accessible data directly.
+    if ( Kokkos::Impl::SpaceAccessibility<
+         Kokkos::HostSpace,kokkos_memory_space>::accessible )
+    {
+        Kokkos::fence();
+        file.write( data, bytes );
+    }
+
+    // Otherwise stage whole structs through host memory.
+    else
+    {
+        std::size_t chunk_bytes =
+            std::max( Impl::deepCopyStagingBytes() / sizeof(soa_type),
+                      std::size_t(1) ) * sizeof(soa_type);
+        Kokkos::View<char*,Kokkos::HostSpace> buffer(
+            Kokkos::ViewAllocateWithoutInitializing("Cabana::write"),
+            std::min(chunk_bytes,bytes) );
+        for ( std::size_t offset = 0; offset < bytes; offset += chunk_bytes )
+        {
+            std::size_t num_bytes = std::min( chunk_bytes, bytes - offset );
+            Kokkos::Impl::DeepCopy<Kokkos::HostSpace,kokkos_memory_space>(
+                buffer.data(), data + offset, num_bytes );
+            Kokkos::fence();
+            file.write( buffer.data(), num_bytes );
+        }
+    }
+
+    file.close();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Read an AoSoA from a binary checkpoint file.
+
+  \param filename The file to read.
+
+  \param aosoa The AoSoA to read into. It is resized to the number of tuples
+  in the file and its existing tuples are overwritten.
+
+  The member types of the file must match those of the AoSoA. If the file
+  was written with the layout of the AoSoA then the structs are read as a
+  single block. Otherwise, e.g. if the vector length differs, the structs
+  are re-blocked as they are read. Data in memory which is not host
+  accessible is read through a host buffer.
+*/
+template<class AoSoA_t>
+void read( const std::string& filename,
+           AoSoA_t& aosoa,
+           typename std::enable_if<is_aosoa<AoSoA_t>::value,int>::type * = 0 )
+{
+    using soa_type = typename AoSoA_t::soa_type;
+    using kokkos_memory_space =
+        typename AoSoA_t::memory_space::kokkos_memory_space;
+
+    Impl::CheckpointFile file( filename, "rb" );
+
+    // Check the header and the member types.
+    Impl::CheckpointHeader header;
+    file.read( &header, sizeof(header) );
+    Impl::checkCheckpointHeader<AoSoA_t>( header );
+    std::vector<Impl::CheckpointMember> src_members( header.number_of_members );
+    file.read( src_members.data(),
+               src_members.size() * sizeof(Impl::CheckpointMember) );
+    std::vector<Impl::CheckpointMember> dst_members =
+        Impl::checkpointMembers<AoSoA_t>();
+    bool same_layout =
+        Impl::checkCheckpointMembers<AoSoA_t>( header, src_members );
+    file.seek( header.data_offset );
+
+    aosoa.resize( WithoutInitializing, header.size );
+    if ( 0 == header.size ) return;
+
+    bool host_accessible = Kokkos::Impl::SpaceAccessibility<
+        Kokkos::HostSpace,kokkos_memory_space>::accessible;
+    std::size_t bytes = aosoa.numSoA() * sizeof(soa_type);
+    char* data = static_cast<char*>( aosoa.ptr() );
+
+    // Read a block with the same layout directly into host accessible data.
+    if ( same_layout && host_accessible )
+    {
+        Kokkos::fence();
+        file.read( data, bytes );
+    }
+
+    // Stage a block with the same layout through host memory.
+    else if ( same_layout )
+    {
+        std::size_t chunk_bytes =
+            std::max( Impl::deepCopyStagingBytes() / sizeof(soa_type),
+                      std::size_t(1) ) * sizeof(soa_type);
+        Kokkos::View<char*,Kokkos::HostSpace> buffer(
+            Kokkos::ViewAllocateWithoutInitializing("Cabana::read"),
+            std::min(chunk_bytes,bytes) );
+        for ( std::size_t offset = 0; offset < bytes; offset += chunk_bytes )
+        {
+            std::size_t num_bytes = std::min( chunk_bytes, bytes - offset );
+            file.read( buffer.data(), num_bytes );
+            Kokkos::Impl::DeepCopy<kokkos_memory_space,Kokkos::HostSpace>(
+                data + offset, buffer.data(), num_bytes );
+            Kokkos::fence();
+        }
+    }
+
+    // Re-block a different layout directly into host accessible data.
+    else if ( host_accessible )
+    {
+        Kokkos::fence();
+        Impl::reblockCheckpoint( file, header, src_members, dst_members,
+                                 data, sizeof(soa_type),
+                                 AoSoA_t::vector_length );
+    }
+
+    // Otherwise re-block into a host copy and transfer it.
+    else
+    {
+        AoSoA<typename AoSoA_t::member_types,
+              HostSpace,
+              AoSoA_t::vector_length,
+              AoSoA_t::alignment> host_aosoa( WithoutInitializing,
+                                              header.size );
+        Impl::reblockCheckpoint( file, header, src_members, dst_members,
+                                 static_cast<char*>(host_aosoa.ptr()),
+                                 sizeof(soa_type),
+                                 AoSoA_t::vector_length );
+        deep_copy( aosoa, host_aosoa );
+    }
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Cabana
+
+#endif // end CABANA_CHECKPOINT_HPP
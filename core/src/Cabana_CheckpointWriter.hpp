@@ -0,0 +1,271 @@
+/****************************************************************************
+ * Copyright (c) 2018 by the Cabana authors                                 *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef CABANA_CHECKPOINTWRITER_HPP
+#define CABANA_CHECKPOINTWRITER_HPP
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_Checkpoint.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace Cabana
+{
+//---------------------------------------------------------------------------//
+/*!
+  \class CheckpointWriter
+
+  \brief Writes checkpoint files in a background thread.
+
+  Writing an AoSoA snapshots its structs into a set of host staging buffers
+  in chunks of whole structs. Each filled buffer is handed to a background
+  I/O thread which writes it to the file while the next chunk is copied. The
+  number of buffers bounds the number of chunks waiting to be written such
+  that the snapshot only waits for the I/O thread when all buffers are
+  full. Once write() returns the AoSoA may be modified while the remaining
+  chunks are written. The files have the same format as those written with
+  Cabana::write().
+
+  Errors in the I/O thread are reported by the next call to write() or
+  wait().
+
+  The writer runs a std::thread so targets including this header must link
+  Threads::Threads. It is not included by Cabana_Core.hpp for that reason.
+*/
+class CheckpointWriter
+{
+  public:
+
+    /*!
+      \brief Constructor.
+
+      \param queue_depth The number of host staging buffers.
+
+      \param chunk_bytes The size of each staging buffer in bytes. A buffer
+      always holds at least one struct.
+    */
+    explicit CheckpointWriter( const std::size_t queue_depth = 2,
+                               const std::size_t chunk_bytes =
+                               64 * 1024 * 1024 )
+        : _chunk_bytes( chunk_bytes )
+        , _buffers( std::max(queue_depth,std::size_t(1)) )
+        , _pending( 0 )
+        , _stop( false )
+    {
+        for ( std::size_t b = 0; b < _buffers.size(); ++b )
+            _free_buffers.push_back( b );
+        _thread = std::thread( &CheckpointWriter::run, this );
+    }
+
+    /*!
+      \brief Destructor. Waits for all outstanding writes to complete.
+    */
+    ~CheckpointWriter()
+    {
+        {
+            std::unique_lock<std::mutex> lock( _mutex );
+            _cv.wait( lock, [this](){ return 0 == _pending; } );
+            _stop = true;
+        }
+        _cv.notify_all();
+        _thread.join();
+    }
+
+    CheckpointWriter( const CheckpointWriter& ) = delete;
+    CheckpointWriter& operator=( const CheckpointWriter& ) = delete;
+
+    /*!
+      \brief Snapshot an AoSoA and write it to a checkpoint file in the
+      background.
+
+      \param filename The file to write.
+
+      \param aosoa The AoSoA to write.
+
+      Returns once the last chunk of the AoSoA has been copied to a staging
+      buffer.
+    */
+    template<class AoSoA_t>
+    void write( const std::string& filename,
+                const AoSoA_t& aosoa,
+                typename std::enable_if<is_aosoa<AoSoA_t>::value,int>::type * = 0 )
+    {
+        using soa_type = typename AoSoA_t::soa_type;
+        using kokkos_memory_space =
+            typename AoSoA_t::memory_space::kokkos_memory_space;
+
+        rethrow();
+
+        // Size the chunks to whole structs and grow the buffers if needed
+        // once they are no longer in use.
+        std::size_t chunk_bytes =
+            std::max( _chunk_bytes / sizeof(soa_type), std::size_t(1) ) *
+            sizeof(soa_type);
+        if ( _buffers[0].extent(0) < chunk_bytes )
+        {
+            wait();
+            for ( auto& buffer : _buffers )
+            {
+                buffer = buffer_type();
+                buffer = buffer_type(
+                    Kokkos::ViewAllocateWithoutInitializing(
+                        "Cabana::CheckpointWriter"),
+                    chunk_bytes );
+            }
+        }
+
+        // The header is small so write it directly.
+        std::shared_ptr<Impl::CheckpointFile> file =
+            std::make_shared<Impl::CheckpointFile>( filename, "wb" );
+        Impl::writeCheckpointHeader( *file, aosoa );
+
+        // Snapshot the structs chunk by chunk.
+        std::size_t bytes = aosoa.numSoA() * sizeof(soa_type);
+        const char* data = static_cast<const char*>( aosoa.ptr() );
+        Kokkos::fence();
+        for ( std::size_t offset = 0; offset < bytes; offset += chunk_bytes )
+        {
+            std::size_t num_bytes = std::min( chunk_bytes, bytes - offset );
+            std::size_t b = acquireBuffer();
+            Kokkos::Impl::DeepCopy<Kokkos::HostSpace,kokkos_memory_space>(
+                _buffers[b].data(), data + offset, num_bytes );
+            Kokkos::fence();
+            enqueue( Task{file, b, num_bytes, false} );
+        }
+
+        // Close the file once all of its chunks are written.
+        enqueue( Task{file, 0, 0, true} );
+    }
+
+    /*!
+      \brief Wait for all outstanding writes to complete.
+    */
+    void wait()
+    {
+        {
+            std::unique_lock<std::mutex> lock( _mutex );
+            _cv.wait( lock, [this](){ return 0 == _pending; } );
+        }
+        rethrow();
+    }
+
+  private:
+
+    using buffer_type = Kokkos::View<char*,Kokkos::HostSpace>;
+
+    // A chunk of a file to write or a file to close.
+    struct Task
+    {
+        std::shared_ptr<Impl::CheckpointFile> file;
+        std::size_t buffer;
+        std::size_t bytes;
+        bool close;
+    };
+
+    // Get a free staging buffer, waiting for one if needed.
+    std::size_t acquireBuffer()
+    {
+        std::unique_lock<std::mutex> lock( _mutex );
+        _cv.wait( lock, [this](){ return !_free_buffers.empty(); } );
+        std::size_t b = _free_buffers.back();
+        _free_buffers.pop_back();
+        return b;
+    }
+
+    // Hand a task to the I/O thread.
+    void enqueue( const Task& task )
+    {
+        {
+            std::unique_lock<std::mutex> lock( _mutex );
+            _tasks.push_back( task );
+            ++_pending;
+        }
+        _cv.notify_all();
+    }
+
+    // Rethrow an error from the I/O thread.
+    void rethrow()
+    {
+        std::exception_ptr error;
+        {
+            std::unique_lock<std::mutex> lock( _mutex );
+            std::swap( error, _error );
+        }
+        if ( error ) std::rethrow_exception( error );
+    }
+
+    // I/O thread loop.
+    void run()
+    {
+        std::unique_lock<std::mutex> lock( _mutex );
+        while ( true )
+        {
+            _cv.wait( lock, [this](){ return _stop || !_tasks.empty(); } );
+            if ( _tasks.empty() ) return;
+
+            Task task = _tasks.front();
+            _tasks.pop_front();
+            lock.unlock();
+
+            std::exception_ptr error;
+            try
+            {
+                if ( task.close )
+                    task.file->close();
+                else
+                    task.file->write( _buffers[task.buffer].data(),
+                                      task.bytes );
+            }
+            catch ( ... )
+            {
+                error = std::current_exception();
+            }
+            task.file.reset();
+
+            lock.lock();
+            if ( error && !_error ) _error = error;
+            if ( !task.close ) _free_buffers.push_back( task.buffer );
+            --_pending;
+            _cv.notify_all();
+        }
+    }
+
+  private:
+
+    std::size_t _chunk_bytes;
+    std::vector<buffer_type> _buffers;
+    std::vector<std::size_t> _free_buffers;
+    std::deque<Task> _tasks;
+    std::size_t _pending;
+    bool _stop;
+    std::exception_ptr _error;
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    std::thread _thread;
+};
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Cabana
+
+#endif // end CABANA_CHECKPOINTWRITER_HPP
@@ -13,14 +13,21 @@
 #define CABANA_CORE_HPP
 
 #include <Cabana_AoSoA.hpp>
+#include <Cabana_Append.hpp>
+#include <Cabana_Checkpoint.hpp>
 #include <Cabana_DeepCopy.hpp>
+#include <Cabana_Erase.hpp>
 #include <Cabana_LinkedCellList.hpp>
 #include <Cabana_Macros.hpp>
 #include <Cabana_MemberTypes.hpp>
 #include <Cabana_NeighborList.hpp>
+#include <Cabana_ScratchPool.hpp>
+#include <Cabana_Simd.hpp>
 #include <Cabana_Slice.hpp>
 #include <Cabana_SoA.hpp>
 #include <Cabana_Sort.hpp>
+#include <Cabana_SpaceFillingCurve.hpp>
+#include <Cabana_Subview.hpp>
 #include <Cabana_Tuple.hpp>
 #include <Cabana_Types.hpp>
 #include <Cabana_VerletList.hpp>
@@ -13,16 +13,506 @@
 #define CABANA_DEEPCOPY_HPP
 
 #include <Cabana_AoSoA.hpp>
+#include <Cabana_MemberTypes.hpp>
+#include <Cabana_ScratchPool.hpp>
+#include <Cabana_Slice.hpp>
+#include <Cabana_Subview.hpp>
+#include <impl/Cabana_IndexSequence.hpp>
 #include <impl/Cabana_TypeTraits.hpp>
 
 #include <Kokkos_Core.hpp>
 #include <Kokkos_ExecPolicy.hpp>
 
+#include <algorithm>
 #include <type_traits>
 #include <exception>
 
 namespace Cabana
 {
+namespace Impl
+{
+//---------------------------------------------------------------------------//
+// Maximum size in bytes of the staging buffer used when copying between
+// memory spaces requires a change in data layout.
+inline std::size_t& deepCopyStagingBytes()
+{
+    static std::size_t staging_bytes = 64 * 1024 * 1024;
+    return staging_bytes;
+}
+
+//---------------------------------------------------------------------------//
+// Copy a contiguous range of tuples within a single struct for a given
+// member. Each component of a member is stored contiguously over the vector
+// length in a struct so the range is copied as one contiguous block per
+// component.
+template<std::size_t M, class DstAoSoA, class SrcAoSoA>
+void partialSoAMemberCopy( const DstAoSoA& dst,
+                           const std::size_t dst_s,
+                           const SrcAoSoA& src,
+                           const std::size_t src_s,
+                           const std::size_t a,
+                           const std::size_t n )
+{
+    using dst_memory_space =
+        typename DstAoSoA::memory_space::kokkos_memory_space;
+    using src_memory_space =
+        typename SrcAoSoA::memory_space::kokkos_memory_space;
+    using data_type = typename DstAoSoA::template member_data_type<M>;
+    using value_type = typename DstAoSoA::template member_value_type<M>;
+    constexpr std::size_t num_comp = sizeof(data_type) / sizeof(value_type);
+    constexpr std::size_t vector_length = DstAoSoA::vector_length;
+
+    auto dst_slice = dst.template slice<M>();
+    auto src_slice = src.template slice<M>();
+    value_type* dst_data = dst_slice.data() + dst_s * dst_slice.stride(0) + a;
+    value_type* src_data = src_slice.data() + src_s * src_slice.stride(0) + a;
+    for ( std::size_t c = 0; c < num_comp; ++c )
+        Kokkos::Impl::DeepCopy<dst_memory_space,src_memory_space>(
+            dst_data + c * vector_length,
+            src_data + c * vector_length,
+            n * sizeof(value_type) );
+}
+
+// Static loop over the members for a partial struct copy.
+template<class DstAoSoA, class SrcAoSoA>
+void partialSoACopy( const DstAoSoA& dst,
+                     const std::size_t dst_s,
+                     const SrcAoSoA& src,
+                     const std::size_t src_s,
+                     const std::size_t a,
+                     const std::size_t n,
+                     std::integral_constant<std::size_t,0> )
+{
+    partialSoAMemberCopy<0>( dst, dst_s, src, src_s, a, n );
+}
+
+template<class DstAoSoA, class SrcAoSoA, std::size_t M>
+void partialSoACopy( const DstAoSoA& dst,
+                     const std::size_t dst_s,
+                     const SrcAoSoA& src,
+                     const std::size_t src_s,
+                     const std::size_t a,
+                     const std::size_t n,
+                     std::integral_constant<std::size_t,M> )
+{
+    partialSoAMemberCopy<M>( dst, dst_s, src, src_s, a, n );
+    partialSoACopy( dst, dst_s, src, src_s, a, n,
+                    std::integral_constant<std::size_t,M-1>() );
+}
+
+//---------------------------------------------------------------------------//
+// Copy a range of tuples between AoSoA objects with the same struct layout
+// where both ranges start at the same position within a struct. Whole
+// structs are copied byte-wise. Partial structs at the beginning and end of
+// the range are copied per member so that tuples outside of the destination
+// range are not modified.
+template<class DstAoSoA, class SrcAoSoA>
+void alignedRangeCopy( const DstAoSoA& dst,
+                       const std::size_t dst_begin,
+                       const SrcAoSoA& src,
+                       const std::size_t src_begin,
+                       const std::size_t n )
+{
+    using dst_memory_space =
+        typename DstAoSoA::memory_space::kokkos_memory_space;
+    using src_memory_space =
+        typename SrcAoSoA::memory_space::kokkos_memory_space;
+    using soa_type = typename DstAoSoA::soa_type;
+    using index_type = typename DstAoSoA::index_type;
+    using last_member =
+        std::integral_constant<std::size_t,DstAoSoA::number_of_members-1>;
+
+    static_assert( std::is_same<soa_type,typename SrcAoSoA::soa_type>::value,
+                   "Aligned range copy requires the same struct layout" );
+
+    std::size_t dst_s = index_type::s( dst_begin );
+    std::size_t src_s = index_type::s( src_begin );
+    std::size_t a = index_type::a( dst_begin );
+    std::size_t num_left = n;
+
+    Kokkos::fence();
+
+    // Partial struct at the beginning of the range.
+    if ( 0 < a && 0 < num_left )
+    {
+        std::size_t num_head =
+            std::min( num_left, std::size_t(DstAoSoA::vector_length) - a );
+        partialSoACopy( dst, dst_s, src, src_s, a, num_head, last_member() );
+        ++dst_s;
+        ++src_s;
+        num_left -= num_head;
+    }
+
+    // Whole structs.
+    std::size_t num_soa = index_type::s( num_left );
+    if ( 0 < num_soa )
+    {
+        Kokkos::Impl::DeepCopy<dst_memory_space,src_memory_space>(
+            static_cast<soa_type*>(dst.ptr()) + dst_s,
+            static_cast<const soa_type*>(src.ptr()) + src_s,
+            num_soa * sizeof(soa_type) );
+        dst_s += num_soa;
+        src_s += num_soa;
+    }
+
+    // Partial struct at the end of the range.
+    std::size_t num_tail = index_type::a( num_left );
+    if ( 0 < num_tail )
+        partialSoACopy( dst, dst_s, src, src_s, 0, num_tail, last_member() );
+
+    Kokkos::fence();
+}
+
+//---------------------------------------------------------------------------//
+// Copy a range of tuples between AoSoA objects in the same memory space with
+// a parallel kernel launched on the given execution space instance. The
+// kernel is not fenced. Each thread fills one destination struct by copying
+// the runs of tuples which are contiguous in both the source and
+// destination structs.
+template<class ExecutionSpace, class DstAoSoA, class SrcAoSoA>
+void kernelRangeCopy( const ExecutionSpace& exec_space,
+                      const DstAoSoA& dst,
+                      const std::size_t dst_begin,
+                      const SrcAoSoA& src,
+                      const std::size_t src_begin,
+                      const std::size_t n )
+{
+    using dst_index = typename DstAoSoA::index_type;
+    using src_index = typename SrcAoSoA::index_type;
+    constexpr std::size_t dst_vector_length = DstAoSoA::vector_length;
+    constexpr std::size_t src_vector_length = SrcAoSoA::vector_length;
+
+    if ( 0 == n ) return;
+
+    std::size_t dst_end = dst_begin + n;
+    auto copy_op = KOKKOS_LAMBDA( const std::size_t s )
+    {
+        std::size_t d = ( s * dst_vector_length > dst_begin )
+                        ? s * dst_vector_length : dst_begin;
+        std::size_t d_end = ( (s+1) * dst_vector_length < dst_end )
+                            ? (s+1) * dst_vector_length : dst_end;
+        while ( d < d_end )
+        {
+            std::size_t i = src_begin + ( d - dst_begin );
+            std::size_t run = src_vector_length - src_index::a(i);
+            if ( d_end - d < run ) run = d_end - d;
+            Impl::tupleRangeCopy(
+                dst.access( s ), dst_index::a(d),
+                src.access( src_index::s(i) ), src_index::a(i), run );
+            d += run;
+        }
+    };
+    Kokkos::RangePolicy<ExecutionSpace> exec_policy(
+        exec_space, dst_index::s(dst_begin), dst_index::s(dst_end - 1) + 1 );
+    Kokkos::parallel_for( "Cabana::kernelRangeCopy", exec_policy, copy_op );
+}
+
+//---------------------------------------------------------------------------//
+// Copy a range of tuples between AoSoA objects in the same memory space with
+// a parallel kernel in the destination execution space.
+template<class DstAoSoA, class SrcAoSoA>
+void kernelRangeCopy( const DstAoSoA& dst,
+                      const std::size_t dst_begin,
+                      const SrcAoSoA& src,
+                      const std::size_t src_begin,
+                      const std::size_t n )
+{
+    using kokkos_execution_space =
+        typename DstAoSoA::memory_space::kokkos_execution_space;
+    kernelRangeCopy( kokkos_execution_space(), dst, dst_begin,
+                     src, src_begin, n );
+    Kokkos::fence();
+}
+
+//---------------------------------------------------------------------------//
+// Copy a range of tuples between AoSoA objects with different struct layouts
+// or ranges which are not aligned in the same way within a struct.
+template<class DstAoSoA, class SrcAoSoA>
+void unalignedRangeCopy( const DstAoSoA& dst,
+                         const std::size_t dst_begin,
+                         const SrcAoSoA& src,
+                         const std::size_t src_begin,
+                         const std::size_t n )
+{
+    using dst_memory_space =
+        typename DstAoSoA::memory_space::kokkos_memory_space;
+    using src_memory_space =
+        typename SrcAoSoA::memory_space::kokkos_memory_space;
+    using src_soa_type = typename SrcAoSoA::soa_type;
+    using src_index = typename SrcAoSoA::index_type;
+
+    // If the data is in the same memory space copy with a kernel.
+    if ( std::is_same<dst_memory_space,src_memory_space>::value )
+    {
+        kernelRangeCopy( dst, dst_begin, src, src_begin, n );
+    }
+
+    // Otherwise copy the structs containing the source range to the
+    // destination space in chunks of bounded size and copy each chunk with a
+    // kernel. The staging buffer is reused for each chunk.
+    else
+    {
+        using src_mirror_type = AoSoA<typename SrcAoSoA::member_types,
+                                      typename DstAoSoA::memory_space,
+                                      SrcAoSoA::vector_length,
+                                      SrcAoSoA::alignment>;
+        constexpr std::size_t src_vector_length = SrcAoSoA::vector_length;
+
+        std::size_t chunk_size =
+            std::max( deepCopyStagingBytes() / sizeof(src_soa_type),
+                      std::size_t(1) ) * src_vector_length;
+        src_mirror_type src_mirror(
+            WithoutInitializing,
+            std::min( chunk_size, src_index::a(src_begin) + n ) );
+
+        std::size_t offset = 0;
+        while ( offset < n )
+        {
+            std::size_t chunk_begin = src_begin + offset;
+            std::size_t mirror_begin = src_index::a( chunk_begin );
+            std::size_t num_copy =
+                std::min( n - offset, chunk_size - mirror_begin );
+            std::size_t num_soa = src_index::s( mirror_begin + num_copy );
+            if ( 0 < src_index::a( mirror_begin + num_copy ) ) ++num_soa;
+
+            Kokkos::fence();
+            Kokkos::Impl::DeepCopy<dst_memory_space,src_memory_space>(
+                src_mirror.ptr(),
+                static_cast<const src_soa_type*>(src.ptr()) +
+                src_index::s(chunk_begin),
+                num_soa * sizeof(src_soa_type) );
+            Kokkos::fence();
+
+            kernelRangeCopy( dst, dst_begin + offset,
+                             src_mirror, mirror_begin, num_copy );
+            offset += num_copy;
+        }
+    }
+}
+
+//---------------------------------------------------------------------------//
+// Copy a range of tuples between AoSoA objects with the same struct layout.
+template<class DstAoSoA, class SrcAoSoA>
+void layoutRangeCopy( const DstAoSoA& dst,
+                      const std::size_t dst_begin,
+                      const SrcAoSoA& src,
+                      const std::size_t src_begin,
+                      const std::size_t n,
+                      std::true_type )
+{
+    // If the ranges are aligned in the same way within a struct then copy
+    // directly.
+    if ( DstAoSoA::index_type::a(dst_begin) ==
+         SrcAoSoA::index_type::a(src_begin) )
+        alignedRangeCopy( dst, dst_begin, src, src_begin, n );
+    else
+        unalignedRangeCopy( dst, dst_begin, src, src_begin, n );
+}
+
+// Copy a range of tuples between AoSoA objects with different struct
+// layouts.
+template<class DstAoSoA, class SrcAoSoA>
+void layoutRangeCopy( const DstAoSoA& dst,
+                      const std::size_t dst_begin,
+                      const SrcAoSoA& src,
+                      const std::size_t src_begin,
+                      const std::size_t n,
+                      std::false_type )
+{
+    unalignedRangeCopy( dst, dst_begin, src, src_begin, n );
+}
+
+//---------------------------------------------------------------------------//
+// Copy a range of tuples between AoSoA objects.
+template<class DstAoSoA, class SrcAoSoA>
+void rangeDeepCopy( const DstAoSoA& dst,
+                    const std::size_t dst_begin,
+                    const SrcAoSoA& src,
+                    const std::size_t src_begin,
+                    const std::size_t n )
+{
+    static_assert(
+        std::is_same<typename DstAoSoA::member_types,
+        typename SrcAoSoA::member_types>::value,
+        "Attempted to deep copy AoSoA objects of different member types" );
+
+    if ( 0 == n ) return;
+
+    layoutRangeCopy(
+        dst, dst_begin, src, src_begin, n,
+        std::integral_constant<
+        bool,std::is_same<typename DstAoSoA::soa_type,
+        typename SrcAoSoA::soa_type>::value>() );
+}
+
+//---------------------------------------------------------------------------//
+// Copy the data of one slice to another with a kernel in the execution space
+// of the destination. Both slices must be accessible from that space but may
+// have different vector lengths.
+template<class DstSlice, class SrcSlice>
+void sliceKernelCopy( const DstSlice& dst, const SrcSlice& src )
+{
+    using dst_index = typename DstSlice::index_type;
+    using src_index = typename SrcSlice::index_type;
+    using kokkos_execution_space =
+        typename DstSlice::kokkos_execution_space;
+    constexpr std::size_t dst_vector_length = DstSlice::vector_length;
+    constexpr std::size_t src_vector_length = SrcSlice::vector_length;
+
+    // Each component of a member is stored contiguously over the vector
+    // length within a struct.
+    std::size_t num_comp = 1;
+    for ( int d = 2; d < dst.rank(); ++d )
+        num_comp *= dst.extent(d);
+
+    auto dst_data = dst.data();
+    auto src_data = src.data();
+    std::size_t dst_stride = dst.stride(0);
+    std::size_t src_stride = src.stride(0);
+    auto copy_op = KOKKOS_LAMBDA( const std::size_t i )
+    {
+        std::size_t dst_offset =
+            dst_index::s(i) * dst_stride + dst_index::a(i);
+        std::size_t src_offset =
+            src_index::s(i) * src_stride + src_index::a(i);
+        for ( std::size_t c = 0; c < num_comp; ++c )
+            dst_data[ dst_offset + c * dst_vector_length ] =
+                src_data[ src_offset + c * src_vector_length ];
+    };
+    Kokkos::RangePolicy<kokkos_execution_space> exec_policy( 0, dst.size() );
+    Kokkos::parallel_for( "Cabana::sliceKernelCopy", exec_policy, copy_op );
+    Kokkos::fence();
+}
+
+//---------------------------------------------------------------------------//
+// Copy a subset of members between AoSoA objects in the same memory space.
+template<class DstAoSoA, class SrcAoSoA>
+void memberKernelCopy( const DstAoSoA&, const SrcAoSoA&, IndexSequence<> )
+{}
+
+template<class DstAoSoA, class SrcAoSoA, std::size_t M, std::size_t... Ms>
+void memberKernelCopy( const DstAoSoA& dst,
+                       const SrcAoSoA& src,
+                       IndexSequence<M,Ms...> )
+{
+    sliceKernelCopy( dst.template slice<M>(), src.template slice<M>() );
+    memberKernelCopy( dst, src, IndexSequence<Ms...>() );
+}
+
+//---------------------------------------------------------------------------//
+// Temporary AoSoA whose structs are drawn from the scratch pool of its
+// memory space. The AoSoA must not be used after this object is destroyed.
+template<class AoSoA_t>
+class ScratchAoSoA
+{
+  public:
+
+    using soa_type = typename AoSoA_t::soa_type;
+    using kokkos_memory_space =
+        typename AoSoA_t::memory_space::kokkos_memory_space;
+
+    ScratchAoSoA( const std::string& label, const std::size_t n )
+        : _structs( label, (n + AoSoA_t::vector_length - 1) /
+                    AoSoA_t::vector_length )
+        , _aosoa( _structs.view().data(), n,
+                  _structs.view().extent(0) * sizeof(soa_type),
+                  AoSoA_t::vector_length )
+    {}
+
+    // Get the AoSoA.
+    const AoSoA_t& aosoa() const
+    { return _aosoa; }
+
+  private:
+
+    ScratchView<soa_type,kokkos_memory_space> _structs;
+    AoSoA_t _aosoa;
+};
+
+//---------------------------------------------------------------------------//
+// Pack a subset of members of an AoSoA into an AoSoA containing only those
+// members. Member J of the packed AoSoA receives member M of the source.
+template<std::size_t J, class PackedAoSoA, class SrcAoSoA>
+void packMembers( const PackedAoSoA&, const SrcAoSoA&, IndexSequence<> )
+{}
+
+template<std::size_t J, class PackedAoSoA, class SrcAoSoA,
+         std::size_t M, std::size_t... Ms>
+void packMembers( const PackedAoSoA& packed,
+                  const SrcAoSoA& src,
+                  IndexSequence<M,Ms...> )
+{
+    sliceKernelCopy( packed.template slice<J>(), src.template slice<M>() );
+    packMembers<J+1>( packed, src, IndexSequence<Ms...>() );
+}
+
+//---------------------------------------------------------------------------//
+// Unpack an AoSoA containing a subset of members into the full AoSoA. Member
+// M of the destination receives member J of the packed AoSoA.
+template<std::size_t J, class DstAoSoA, class PackedAoSoA>
+void unpackMembers( const DstAoSoA&, const PackedAoSoA&, IndexSequence<> )
+{}
+
+template<std::size_t J, class DstAoSoA, class PackedAoSoA,
+         std::size_t M, std::size_t... Ms>
+void unpackMembers( const DstAoSoA& dst,
+                    const PackedAoSoA& packed,
+                    IndexSequence<M,Ms...> )
+{
+    sliceKernelCopy( dst.template slice<M>(), packed.template slice<J>() );
+    unpackMembers<J+1>( dst, packed, IndexSequence<Ms...>() );
+}
+
+//---------------------------------------------------------------------------//
+
+//---------------------------------------------------------------------------//
+// Re-block the data of an AoSoA into an AoSoA with a different data layout
+// with a kernel launched on the given execution space instance. Used when
+// the instance can access both AoSoA objects.
+template<class ExecutionSpace, class DstAoSoA, class SrcAoSoA>
+void asyncLayoutCopy( const ExecutionSpace& exec_space,
+                      const DstAoSoA& dst,
+                      const SrcAoSoA& src,
+                      std::true_type )
+{
+    kernelRangeCopy( exec_space, dst, 0, src, 0, src.size() );
+}
+
+//---------------------------------------------------------------------------//
+// Re-block the data of an AoSoA into an AoSoA with a different data layout
+// when the given execution space instance cannot access both AoSoA
+// objects. The data is staged through a temporary buffer so this copy is
+// synchronous.
+template<class ExecutionSpace, class DstAoSoA, class SrcAoSoA>
+void asyncLayoutCopy( const ExecutionSpace& exec_space,
+                      const DstAoSoA& dst,
+                      const SrcAoSoA& src,
+                      std::false_type )
+{
+    exec_space.fence();
+    unalignedRangeCopy( dst, 0, src, 0, src.size() );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Impl
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Set the maximum size of the staging buffer used by deep copies
+  between memory spaces that change the data layout.
+
+  \param bytes The maximum staging buffer size in bytes. At least one struct
+  is always staged.
+
+  Larger buffers require fewer transfers while smaller buffers bound the
+  additional memory required to change the layout of large containers.
+*/
+inline void setDeepCopyStagingBytes( const std::size_t bytes )
+{
+    Impl::deepCopyStagingBytes() = bytes;
+}
+
 //---------------------------------------------------------------------------//
 /*!
   \brief Deep copy data between compatible AoSoA objects.
@@ -99,38 +589,339 @@ inline void deep_copy(
     }
 
     // Otherwise copy the data element-by-element because the data layout is
-    // different.
+    // different. Data in the same memory space is re-blocked directly while
+    // data in different memory spaces is staged in bounded chunks.
+    else
+    {
+        Impl::unalignedRangeCopy( dst, 0, src, 0, src.size() );
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Asynchronously deep copy data between compatible AoSoA objects.
+
+  \param exec_space The execution space instance in which the copy is
+  ordered.
+
+  \param dst The destination for the copied data.
+
+  \param src The source of the copied data.
+
+  Only AoSoA objects with the same set of member data types and size may be
+  copied. The copy is enqueued in the given execution space instance and no
+  global fence is performed so the function may return before the copy is
+  complete. Neither AoSoA may be resized or deallocated and the destination
+  may not be accessed until the instance has been fenced with
+  Cabana::fence(). Copies which change the data layout between memory spaces
+  the instance cannot access are staged through a temporary buffer and are
+  completed before returning.
+*/
+template<class ExecutionSpace, class DstAoSoA, class SrcAoSoA>
+inline void deep_copy(
+    const ExecutionSpace& exec_space,
+    DstAoSoA& dst,
+    const SrcAoSoA& src,
+    typename std::enable_if<(Kokkos::is_execution_space<ExecutionSpace>::value &&
+                             is_aosoa<DstAoSoA>::value &&
+                             is_aosoa<SrcAoSoA>::value)>::type *  = 0 )
+{
+    using dst_type = DstAoSoA;
+    using src_type = SrcAoSoA;
+    using dst_memory_space =
+        typename dst_type::memory_space::kokkos_memory_space;
+    using src_memory_space =
+        typename src_type::memory_space::kokkos_memory_space;
+    using dst_soa_type = typename dst_type::soa_type;
+    using src_soa_type = typename src_type::soa_type;
+
+    // Check that the data types are the same.
+    static_assert(
+        std::is_same<typename dst_type::member_types,
+        typename src_type::member_types>::value,
+        "Attempted to deep copy AoSoA objects of different member types" );
+
+    // Check for the same number of values.
+    if ( dst.size() != src.size() )
+    {
+        throw std::runtime_error(
+            "Attempted to deep copy AoSoA objects of different sizes" );
+    }
+
+    // Get the pointers to the beginning of the data blocks.
+    void* dst_data = dst.ptr();
+    const void* src_data = src.ptr();
+
+    // Return if both pointers are null.
+    if ( dst_data == nullptr && src_data == nullptr ) return;
+
+    // Return if the AoSoA memory occupies the same space.
+    if ( (dst_data == src_data) &&
+         (dst.numSoA() * sizeof(dst_soa_type) ==
+          src.numSoA() * sizeof(src_soa_type)) )
+        return;
+
+    // If the data layout is the same then enqueue a byte-wise copy.
+    if ( std::is_same<dst_soa_type,src_soa_type>::value &&
+         ( dst_type::vector_length == src_type::vector_length ) )
+    {
+        Kokkos::Impl::DeepCopy<dst_memory_space,src_memory_space,ExecutionSpace>(
+            exec_space, dst_data, src_data,
+            dst.numSoA() * sizeof(dst_soa_type) );
+    }
+
+    // Otherwise re-block the data. This is enqueued if the instance can
+    // access both AoSoA objects.
+    else
+    {
+        using can_enqueue = std::integral_constant<
+            bool,
+            (std::is_same<dst_memory_space,src_memory_space>::value &&
+             Kokkos::Impl::SpaceAccessibility<
+             ExecutionSpace,dst_memory_space>::accessible)>;
+        Impl::asyncLayoutCopy( exec_space, dst, src, can_enqueue() );
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Wait for all work enqueued in an execution space instance,
+  including asynchronous deep copies, to complete.
+
+  \param exec_space The execution space instance to fence.
+*/
+template<class ExecutionSpace>
+inline void fence(
+    const ExecutionSpace& exec_space,
+    typename std::enable_if<
+    Kokkos::is_execution_space<ExecutionSpace>::value>::type * = 0 )
+{
+    exec_space.fence();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Deep copy data between compatible AoSoA subviews.
+
+  \param dst The destination for the copied data.
+
+  \param src The source of the copied data.
+
+  Only subviews with the same set of member data types and size may be
+  copied. Only the tuples in the ranges of the subviews are copied. When the
+  struct layouts match and both ranges start at the same position within a
+  struct the whole structs in the range are copied byte-wise.
+*/
+template<class DstSubview, class SrcSubview>
+inline void deep_copy(
+    const DstSubview& dst,
+    const SrcSubview& src,
+    typename std::enable_if<(is_aosoa_subview<DstSubview>::value &&
+                             is_aosoa_subview<SrcSubview>::value)>::type * = 0 )
+{
+    if ( dst.size() != src.size() )
+    {
+        throw std::runtime_error(
+            "Attempted to deep copy AoSoA subviews of different sizes" );
+    }
+
+    Impl::rangeDeepCopy( dst.aosoa(), dst.rangeBegin(),
+                         src.aosoa(), src.rangeBegin(),
+                         src.size() );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Deep copy data from an AoSoA subview to a compatible AoSoA.
+
+  \param dst The destination for the copied data.
+
+  \param src The source of the copied data.
+*/
+template<class DstAoSoA, class SrcSubview>
+inline void deep_copy(
+    DstAoSoA& dst,
+    const SrcSubview& src,
+    typename std::enable_if<(is_aosoa<DstAoSoA>::value &&
+                             is_aosoa_subview<SrcSubview>::value)>::type * = 0 )
+{
+    deep_copy( subview(dst,0,dst.size()), src );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Deep copy data from an AoSoA to a compatible AoSoA subview.
+
+  \param dst The destination for the copied data.
+
+  \param src The source of the copied data.
+*/
+template<class DstSubview, class SrcAoSoA>
+inline void deep_copy(
+    const DstSubview& dst,
+    const SrcAoSoA& src,
+    typename std::enable_if<(is_aosoa_subview<DstSubview>::value &&
+                             is_aosoa<SrcAoSoA>::value)>::type * = 0 )
+{
+    deep_copy( dst, subview(src,0,src.size()) );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Deep copy a subset of members between compatible AoSoA objects.
+
+  \tparam Members The indices of the members to copy.
+
+  \param dst The destination for the copied data.
+
+  \param src The source of the copied data.
+
+  Only AoSoA objects with the same set of member data types and size may be
+  copied. Members not in the given subset are not modified in the
+  destination. If the AoSoA objects are in different memory spaces then the
+  selected members are first packed into a contiguous buffer in the source
+  space such that they are transferred with a single bulk copy and then
+  unpacked in the destination space. The packed buffers are drawn from the
+  scratch pools of the memory spaces (see reserveScratch()). For example, to
+  copy only members 0 and 2:
+  \code
+  Cabana::deep_copy<0,2>( dst, src );
+  \endcode
+*/
+template<std::size_t... Members, class DstAoSoA, class SrcAoSoA>
+inline void deep_copy(
+    DstAoSoA& dst,
+    const SrcAoSoA& src,
+    typename std::enable_if<(0 < sizeof...(Members) &&
+                             is_aosoa<DstAoSoA>::value &&
+                             is_aosoa<SrcAoSoA>::value)>::type * = 0 )
+{
+    using dst_type = DstAoSoA;
+    using src_type = SrcAoSoA;
+    using dst_memory_space =
+        typename dst_type::memory_space::kokkos_memory_space;
+    using src_memory_space =
+        typename src_type::memory_space::kokkos_memory_space;
+    using member_sequence = Impl::IndexSequence<Members...>;
+
+    // Check that the data types are the same.
+    static_assert(
+        std::is_same<typename dst_type::member_types,
+        typename src_type::member_types>::value,
+        "Attempted to deep copy AoSoA objects of different member types" );
+
+    // Check for the same number of values.
+    if ( dst.size() != src.size() )
+    {
+        throw std::runtime_error(
+            "Attempted to deep copy AoSoA objects of different sizes" );
+    }
+
+    if ( 0 == src.size() ) return;
+
+    // If the data is in the same memory space copy the members directly.
+    if ( std::is_same<dst_memory_space,src_memory_space>::value )
+    {
+        Impl::memberKernelCopy( dst, src, member_sequence() );
+    }
+
+    // Otherwise pack, transfer, and unpack.
     else
     {
-        // Define a AoSoA type in the destination space with the same data
-        // layout as the source.
-        using src_mirror_type = AoSoA<typename src_type::member_types,
+        using packed_types = MemberTypes<
+            typename src_type::template member_data_type<Members>...>;
+        using src_packed_type = AoSoA<packed_types,
+                                      typename src_type::memory_space,
+                                      src_type::vector_length>;
+        using dst_packed_type = AoSoA<packed_types,
                                       typename dst_type::memory_space,
                                       src_type::vector_length>;
-        static_assert(
-            std::is_same<src_soa_type,typename src_mirror_type::soa_type>::value,
-            "Incompatible source mirror type in destination space" );
 
-        // Create an AoSoA in the destination space with the same data layout
-        // as the source.
-        src_mirror_type src_copy_on_dst( src.size() );
+        Impl::ScratchAoSoA<src_packed_type> src_packed(
+            "Cabana::deep_copy::src_packed", src.size() );
+        Impl::packMembers<0>( src_packed.aosoa(), src, member_sequence() );
 
-        // Copy the source to the destination space.
-        Kokkos::fence();
-        Kokkos::Impl::DeepCopy<dst_memory_space,src_memory_space>(
-            src_copy_on_dst.ptr(),
-            src_data,
-            src_num_soa * sizeof(src_soa_type) );
-        Kokkos::fence();
+        Impl::ScratchAoSoA<dst_packed_type> dst_packed(
+            "Cabana::deep_copy::dst_packed", src.size() );
+        deep_copy( dst_packed.aosoa(), src_packed.aosoa() );
 
-        // Copy via tuples.
-        auto copy_func =
-            KOKKOS_LAMBDA( const std::size_t i )
-            { dst.setTuple( i, src_copy_on_dst.getTuple(i) ); };
-        Kokkos::RangePolicy<typename dst_memory_space::execution_space>
-            exec_policy( 0, dst.size() );
-        Kokkos::parallel_for( "Cabana::deep_copy", exec_policy, copy_func );
-        Kokkos::fence();
+        Impl::unpackMembers<0>( dst, dst_packed.aosoa(), member_sequence() );
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Deep copy data between compatible slices.
+
+  \param dst The destination for the copied data.
+
+  \param src The source of the copied data.
+
+  Only slices of the same member data type and size may be copied. The
+  source slice may be a read-only slice of const data. The slices may have
+  different vector lengths. Only the data of the given
+  member is transferred. If the slices are in different memory spaces then
+  the source data is first packed into a contiguous buffer in the source
+  space such that it is transferred with a single bulk copy. The packed
+  buffers are drawn from the scratch pools of the memory spaces.
+*/
+template<class DstDataType,
+         class DstMemorySpace, class DstMemoryAccessType,
+         int DstVectorLength, int DstAlignment,
+         class SrcDataType,
+         class SrcMemorySpace, class SrcMemoryAccessType,
+         int SrcVectorLength, int SrcAlignment>
+inline void deep_copy(
+    const Slice<DstDataType,DstMemorySpace,DstMemoryAccessType,
+                DstVectorLength,DstAlignment>& dst,
+    const Slice<SrcDataType,SrcMemorySpace,SrcMemoryAccessType,
+                SrcVectorLength,SrcAlignment>& src,
+    typename std::enable_if<
+    std::is_same<typename std::remove_const<DstDataType>::type,
+                 typename std::remove_const<SrcDataType>::type>::value,
+    int>::type * = 0 )
+{
+    static_assert( !std::is_const<DstDataType>::value,
+                   "Cannot deep copy into a slice of const data" );
+
+    using DataType = typename std::remove_const<SrcDataType>::type;
+    using dst_memory_space = typename DstMemorySpace::kokkos_memory_space;
+    using src_memory_space = typename SrcMemorySpace::kokkos_memory_space;
+
+    // Check for the same number of values.
+    if ( dst.size() != src.size() )
+    {
+        throw std::runtime_error(
+            "Attempted to deep copy slices of different sizes" );
+    }
+
+    if ( 0 == src.size() ) return;
+
+    // If the data is in the same memory space copy directly.
+    if ( std::is_same<dst_memory_space,src_memory_space>::value )
+    {
+        Impl::sliceKernelCopy( dst, src );
+    }
+
+    // Otherwise pack, transfer, and unpack.
+    else
+    {
+        using src_packed_type = AoSoA<MemberTypes<DataType>,
+                                      SrcMemorySpace,
+                                      SrcVectorLength>;
+        using dst_packed_type = AoSoA<MemberTypes<DataType>,
+                                      DstMemorySpace,
+                                      SrcVectorLength>;
+
+        Impl::ScratchAoSoA<src_packed_type> src_packed(
+            "Cabana::deep_copy::src_packed", src.size() );
+        Impl::sliceKernelCopy( src_packed.aosoa().template slice<0>(), src );
+
+        Impl::ScratchAoSoA<dst_packed_type> dst_packed(
+            "Cabana::deep_copy::dst_packed", src.size() );
+        deep_copy( dst_packed.aosoa(), src_packed.aosoa() );
+
+        Impl::sliceKernelCopy( dst, dst_packed.aosoa().template slice<0>() );
     }
 }
 
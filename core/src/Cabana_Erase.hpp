@@ -0,0 +1,221 @@
+/****************************************************************************
+ * Copyright (c) 2018 by the Cabana authors                                 *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef CABANA_ERASE_HPP
+#define CABANA_ERASE_HPP
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_SoA.hpp>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_ExecPolicy.hpp>
+
+#include <type_traits>
+#include <stdexcept>
+
+namespace Cabana
+{
+namespace Impl
+{
+//---------------------------------------------------------------------------//
+// Remove the tuples of an AoSoA for which the given functor returns true by
+// moving the tuples that are kept from the back of the container into the
+// holes left by the removed tuples at the front of the container. Only the
+// tuples which are out of place are moved. The functor is evaluated several
+// times for each tuple while tuples are moved so it must not depend on the
+// data of the AoSoA. Returns the number of tuples removed.
+template<class AoSoA_t, class RemoveFunctor>
+std::size_t compactAoSoA( AoSoA_t& aosoa, const RemoveFunctor& is_removed )
+{
+    using kokkos_memory_space =
+        typename AoSoA_t::memory_space::kokkos_memory_space;
+    using kokkos_execution_space =
+        typename AoSoA_t::memory_space::kokkos_execution_space;
+    using index_type = typename AoSoA_t::index_type;
+    constexpr std::size_t vector_length = AoSoA_t::vector_length;
+
+    std::size_t num_tuple = aosoa.size();
+
+    // Count the number of tuples that will be kept.
+    std::size_t num_keep = 0;
+    Kokkos::RangePolicy<kokkos_execution_space> count_policy( 0, num_tuple );
+    auto count_op = KOKKOS_LAMBDA( const std::size_t i, std::size_t& count )
+                    { if ( !is_removed(i) ) ++count; };
+    Kokkos::parallel_reduce(
+        "Cabana::compactAoSoA::count", count_policy, count_op, num_keep );
+    Kokkos::fence();
+
+    // The number of tuples kept in the back of the container is the same as
+    // the number of holes in the front of the container.
+    std::size_t num_hole = 0;
+    Kokkos::RangePolicy<kokkos_execution_space> tail_policy(
+        num_keep, num_tuple );
+    Kokkos::parallel_reduce(
+        "Cabana::compactAoSoA::tail_count", tail_policy, count_op, num_hole );
+    Kokkos::fence();
+
+    if ( 0 < num_hole )
+    {
+        // Gather the indices of the tuples kept in the back of the container.
+        Kokkos::View<std::size_t*,kokkos_memory_space> keep_ids(
+            Kokkos::ViewAllocateWithoutInitializing("keep_ids"), num_hole );
+        auto gather_op = KOKKOS_LAMBDA( const std::size_t i,
+                                        std::size_t& offset,
+                                        const bool final_pass )
+        {
+            if ( !is_removed(i) )
+            {
+                if ( final_pass ) keep_ids( offset ) = i;
+                ++offset;
+            }
+        };
+        Kokkos::parallel_scan(
+            "Cabana::compactAoSoA::gather", tail_policy, gather_op );
+        Kokkos::fence();
+
+        // Fill the holes in the front of the container. Consecutive holes
+        // filled by consecutive kept tuples in the same pair of structs are
+        // copied as a single run by the first hole of the run. The source
+        // and destination tuples are disjoint so the copies are independent.
+        Kokkos::RangePolicy<kokkos_execution_space> front_policy( 0, num_keep );
+        auto fill_op = KOKKOS_LAMBDA( const std::size_t i,
+                                      std::size_t& offset,
+                                      const bool final_pass )
+        {
+            if ( is_removed(i) )
+            {
+                if ( final_pass )
+                {
+                    std::size_t j = keep_ids( offset );
+                    std::size_t a_i = index_type::a(i);
+                    std::size_t a_j = index_type::a(j);
+                    bool run_begin =
+                        ( 0 == a_i || 0 == a_j || !is_removed(i-1) ||
+                          keep_ids(offset-1) != j - 1 );
+                    if ( run_begin )
+                    {
+                        std::size_t n = 1;
+                        while ( a_i + n < vector_length &&
+                                a_j + n < vector_length &&
+                                i + n < num_keep &&
+                                is_removed(i+n) &&
+                                keep_ids(offset+n) == j + n )
+                            ++n;
+                        Impl::tupleRangeCopy( aosoa.access( index_type::s(i) ),
+                                              a_i,
+                                              aosoa.access( index_type::s(j) ),
+                                              a_j, n );
+                    }
+                }
+                ++offset;
+            }
+        };
+        Kokkos::parallel_scan(
+            "Cabana::compactAoSoA::fill", front_policy, fill_op );
+        Kokkos::fence();
+    }
+
+    // Shrink the container.
+    aosoa.resize( num_keep );
+
+    return num_tuple - num_keep;
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Impl
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Remove the tuples of an AoSoA marked by a mask.
+
+  \param aosoa The AoSoA to remove tuples from.
+
+  \param mask A Kokkos View of booleans with one entry per tuple in the
+  AoSoA. Tuples with a true mask value are removed.
+
+  \return The number of tuples removed.
+
+  The removal is performed in parallel in-place. Tuples which are kept are
+  moved from the back of the container into the holes left by the removed
+  tuples so the relative order of the remaining tuples is not preserved. The
+  container size is reduced but its capacity is not changed.
+*/
+template<class AoSoA_t, class MaskView>
+std::size_t erase(
+    AoSoA_t& aosoa,
+    const MaskView& mask,
+    typename std::enable_if<(is_aosoa<AoSoA_t>::value &&
+                             Kokkos::is_view<MaskView>::value),int>::type * = 0 )
+{
+    static_assert(
+        std::is_same<typename MaskView::memory_space,
+        typename AoSoA_t::memory_space::kokkos_memory_space>::value,
+        "Erase mask must be in the same memory space as the AoSoA" );
+
+    if ( mask.extent(0) != aosoa.size() )
+        throw std::runtime_error( "Erase mask size does not match AoSoA size" );
+
+    auto is_removed = KOKKOS_LAMBDA( const std::size_t i ) -> bool
+                      { return mask( i ); };
+    return Impl::compactAoSoA( aosoa, is_removed );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Remove the tuples of an AoSoA for which a predicate is true.
+
+  \param aosoa The AoSoA to remove tuples from.
+
+  \param pred A functor with signature bool( const std::size_t i ) which
+  returns true if the tuple at index i should be removed. The predicate is
+  evaluated once for each tuple in the execution space of the AoSoA before
+  any tuples are moved so it may depend on the data of tuple i.
+
+  \return The number of tuples removed.
+
+  The removal is performed in parallel in-place. Tuples which are kept are
+  moved from the back of the container into the holes left by the removed
+  tuples so the relative order of the remaining tuples is not preserved. The
+  container size is reduced but its capacity is not changed.
+*/
+template<class AoSoA_t, class Predicate>
+std::size_t remove_if(
+    AoSoA_t& aosoa,
+    const Predicate& pred,
+    typename std::enable_if<(is_aosoa<AoSoA_t>::value &&
+                             !Kokkos::is_view<Predicate>::value),int>::type * = 0 )
+{
+    using kokkos_memory_space =
+        typename AoSoA_t::memory_space::kokkos_memory_space;
+    using kokkos_execution_space =
+        typename AoSoA_t::memory_space::kokkos_execution_space;
+
+    // Evaluate the predicate into a mask before the data is moved.
+    Kokkos::View<bool*,kokkos_memory_space> mask(
+        Kokkos::ViewAllocateWithoutInitializing("remove_if_mask"),
+        aosoa.size() );
+    auto mask_op = KOKKOS_LAMBDA( const std::size_t i )
+                   { mask( i ) = pred( i ); };
+    Kokkos::parallel_for(
+        "Cabana::remove_if::mask",
+        Kokkos::RangePolicy<kokkos_execution_space>( 0, aosoa.size() ),
+        mask_op );
+    Kokkos::fence();
+
+    return erase( aosoa, mask );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Cabana
+
+#endif // end CABANA_ERASE_HPP
@@ -19,8 +19,24 @@
 
 #include <Kokkos_Core.hpp>
 
+#include <stdexcept>
+#include <utility>
+
 namespace Cabana
 {
+//---------------------------------------------------------------------------//
+/*!
+  \brief The path taken by LinkedCellList::update().
+
+  Incremental updates patch the bins of the particles which changed cell.
+  Full updates rebin all particles.
+*/
+enum class LinkedCellListUpdate
+{
+    Incremental,
+    Full
+};
+
 //---------------------------------------------------------------------------//
 /*!
   \class LinkedCellList
@@ -63,9 +79,6 @@ class LinkedCellList
         const typename SliceType::value_type grid_min[3],
         const typename SliceType::value_type grid_max[3],
         typename std::enable_if<(is_slice<SliceType>::value),int>::type * = 0 )
-        : _grid( grid_min[0], grid_min[1], grid_min[2],
-                 grid_max[0], grid_max[1], grid_max[2],
-                 grid_delta[0], grid_delta[1], grid_delta[2] )
     {
         build( positions, 0, positions.size(), grid_delta, grid_min, grid_max );
     }
@@ -96,9 +109,6 @@ class LinkedCellList
         const typename SliceType::value_type grid_min[3],
         const typename SliceType::value_type grid_max[3],
         typename std::enable_if<(is_slice<SliceType>::value),int>::type * = 0 )
-        : _grid( grid_min[0], grid_min[1], grid_min[2],
-                 grid_max[0], grid_max[1], grid_max[2],
-                 grid_delta[0], grid_delta[1], grid_delta[2] )
     {
         build( positions, begin, end, grid_delta, grid_min, grid_max );
     }
@@ -205,8 +215,31 @@ class LinkedCellList
 
   public:
 
-    // This function should be private but we need to expose it as public to
-    // launch CUDA kernels with class data.
+    /*!
+      \brief Rebuild the linked cell list.
+
+      \tparam SliceType Slice type for positions.
+
+      \param positions Slice of positions.
+
+      \param begin The beginning index of the AoSoA range to sort.
+
+      \param end The end index of the AoSoA range to sort.
+
+      \param grid_delta Grid sizes in each cardinal direction.
+
+      \param grid_min Grid minimum value in each direction.
+
+      \param grid_max Grid maximum value in each direction.
+
+      The binning data of the previous build is reused when it is large
+      enough so rebuilding a list with the same grid and number of particles
+      does not allocate memory. Binning data previously obtained from this
+      list is overwritten.
+
+      This function is public so CUDA kernels may be launched with class
+      data.
+    */
     template<class SliceType>
     void build( SliceType positions,
                 const std::size_t begin,
@@ -215,12 +248,215 @@ class LinkedCellList
                 const typename SliceType::value_type grid_min[3],
                 const typename SliceType::value_type grid_max[3] )
     {
-        // Allocate the binning data. Note that the permutation vector spans
-        // only the length of begin-end;
+        _grid = Impl::CartesianGrid<double>(
+            grid_min[0], grid_min[1], grid_min[2],
+            grid_max[0], grid_max[1], grid_max[2],
+            grid_delta[0], grid_delta[1], grid_delta[2] );
+        binParticles( positions, begin, end );
+    }
+
+    /*!
+      \brief Update the linked cell list after the particles moved.
+
+      \tparam SliceType Slice type for positions.
+
+      \param positions Slice of positions. The particles must be in the same
+      order as in the last build or update.
+
+      \param rebuild_fraction The fraction of the particles in the range
+      which may change cell for the list to be updated incrementally.
+
+      \return The path taken by the update.
+
+      The grid and particle range of the last build are kept. The cell of
+      every particle is located and compared to its cell in the list. If at
+      most the given fraction of the particles changed cell then only the
+      particles which did are moved between bins: the bins keep the
+      particles which stayed in the same order and the particles which
+      arrived are appended to them. Otherwise all particles are rebinned as
+      in build(). Binning data previously obtained from this list is
+      invalidated.
+
+      This function is public so CUDA kernels may be launched with class
+      data.
+    */
+    template<class SliceType>
+    LinkedCellListUpdate update( SliceType positions,
+                                 const double rebuild_fraction = 0.02 )
+    {
+        if ( 0 == _counts.extent(0) )
+            throw std::runtime_error(
+                "Attempted to update a LinkedCellList which was not built" );
+
+        std::size_t begin = _bin_data.rangeBegin();
+        std::size_t end = _bin_data.rangeEnd();
+        if ( positions.size() < end )
+            throw std::runtime_error(
+                "LinkedCellList update positions do not cover the range" );
+
+        // Locate the particles and count those which changed cell.
+        std::size_t ncell = totalBins();
+        std::size_t num_particle = end - begin;
+        if ( _next_cells.extent(0) < num_particle )
+            _next_cells =
+                Kokkos::View<int*,KokkosMemorySpace>( "next_cells", num_particle );
+        auto grid = _grid;
+        auto cells = _cells;
+        auto next_cells = _next_cells;
+        Kokkos::RangePolicy<typename OffsetView::execution_space>
+            particle_range( begin, end );
+        auto locate_op =
+            KOKKOS_LAMBDA( const std::size_t p, int& num_moved )
+            {
+                int i, j, k;
+                grid.locatePoint(
+                    positions(p,0), positions(p,1), positions(p,2), i , j, k );
+                int cell_id = grid.cardinalCellIndex(i,j,k);
+                next_cells( p - begin ) = cell_id;
+                if ( cell_id != cells(p - begin) ) ++num_moved;
+            };
+        int num_moved = 0;
+        Kokkos::parallel_reduce( "Cabana::LinkedCellList::update::locate",
+                                 particle_range,
+                                 locate_op,
+                                 num_moved );
+        Kokkos::fence();
+
+        if ( num_moved > rebuild_fraction * num_particle )
+        {
+            binParticles( positions, begin, end );
+            return LinkedCellListUpdate::Full;
+        }
+        if ( 0 == num_moved )
+            return LinkedCellListUpdate::Incremental;
+
+        // Update the counts with the moved particles.
+        if ( _next_counts.extent(0) != ncell )
+        {
+            _next_counts =
+                Kokkos::View<int*,KokkosMemorySpace>( "next_counts", ncell );
+            _next_offsets = OffsetView( "next_offsets", ncell );
+        }
+        if ( _next_permute.extent(0) < num_particle )
+            _next_permute = OffsetView( "next_permute", num_particle );
+        auto counts = _counts;
+        auto offsets = _offsets;
+        auto permute = _permute;
+        auto next_counts = _next_counts;
+        auto next_offsets = _next_offsets;
+        auto next_permute = _next_permute;
+        Kokkos::deep_copy( next_counts, counts );
+        auto move_count =
+            KOKKOS_LAMBDA( const std::size_t p )
+            {
+                int old_cell = cells( p - begin );
+                int new_cell = next_cells( p - begin );
+                if ( old_cell != new_cell )
+                {
+                    Kokkos::atomic_decrement( &next_counts(old_cell) );
+                    Kokkos::atomic_increment( &next_counts(new_cell) );
+                }
+            };
+        Kokkos::parallel_for( "Cabana::LinkedCellList::update::move_count",
+                              particle_range,
+                              move_count );
+        Kokkos::fence();
+
+        // Compute offsets.
+        Kokkos::RangePolicy<typename OffsetView::execution_space>
+            cell_range( 0, ncell );
+        auto offset_scan =
+            KOKKOS_LAMBDA( const std::size_t c, int& update, const bool final_pass )
+            {
+                if ( final_pass ) next_offsets( c ) = update;
+                update += next_counts( c );
+            };
+        Kokkos::parallel_scan( "Cabana::LinkedCellList::update::offset_scan",
+                               cell_range,
+                               offset_scan );
+        Kokkos::fence();
+
+        // Keep the particles which stayed in each bin in order. The counts
+        // are reused to track the number of particles placed in each bin.
+        auto keep_op =
+            KOKKOS_LAMBDA( const std::size_t c )
+            {
+                size_type n = next_offsets( c );
+                for ( size_type q = offsets(c); q < offsets(c) + counts(c); ++q )
+                {
+                    size_type p = permute( q );
+                    if ( int(c) == next_cells(p - begin) )
+                        next_permute( n++ ) = p;
+                }
+                counts( c ) = n - next_offsets( c );
+            };
+        Kokkos::parallel_for( "Cabana::LinkedCellList::update::keep",
+                              cell_range,
+                              keep_op );
+        Kokkos::fence();
+
+        // Append the particles which arrived in each bin.
+        auto arrive_op =
+            KOKKOS_LAMBDA( const std::size_t p )
+            {
+                int new_cell = next_cells( p - begin );
+                if ( cells(p - begin) != new_cell )
+                {
+                    int c = Kokkos::atomic_fetch_add( &counts(new_cell), 1 );
+                    next_permute( next_offsets(new_cell) + c ) = p;
+                }
+            };
+        Kokkos::parallel_for( "Cabana::LinkedCellList::update::arrive",
+                              particle_range,
+                              arrive_op );
+        Kokkos::fence();
+
+        // Swap in the updated bins.
+        std::swap( _counts, _next_counts );
+        std::swap( _offsets, _next_offsets );
+        std::swap( _permute, _next_permute );
+        std::swap( _cells, _next_cells );
+        _bin_data = BinningData<MemorySpace>(
+            begin, end, _counts, _offsets, _permute );
+        return LinkedCellListUpdate::Incremental;
+    }
+
+    /*!
+      \brief Bin the particles in a range on the current grid.
+
+      \tparam SliceType Slice type for positions.
+
+      \param positions Slice of positions.
+
+      \param begin The beginning index of the AoSoA range to sort.
+
+      \param end The end index of the AoSoA range to sort.
+
+      This function is public so CUDA kernels may be launched with class
+      data.
+    */
+    template<class SliceType>
+    void binParticles( SliceType positions,
+                       const std::size_t begin,
+                       const std::size_t end )
+    {
+        // Allocate the binning data if the existing data is not large
+        // enough. Note that the permutation vector spans only the length of
+        // begin-end;
         std::size_t ncell = totalBins();
-        Kokkos::View<int*,KokkosMemorySpace> counts( "counts", ncell );
-        OffsetView offsets( "offsets", ncell );
-        OffsetView permute( "permute", end - begin );
+        if ( _counts.extent(0) != ncell )
+        {
+            _counts = Kokkos::View<int*,KokkosMemorySpace>( "counts", ncell );
+            _offsets = OffsetView( "offsets", ncell );
+        }
+        if ( _permute.extent(0) < end - begin )
+            _permute = OffsetView( "permute", end - begin );
+        if ( _cells.extent(0) < end - begin )
+            _cells = Kokkos::View<int*,KokkosMemorySpace>( "cells", end - begin );
+        auto counts = _counts;
+        auto offsets = _offsets;
+        auto permute = _permute;
+        auto cells = _cells;
 
         // Get a local copy of the grid because it is class data and a lambda
         // function will not capture it otherwise via CUDA.
@@ -271,6 +507,7 @@ class LinkedCellList
                 auto cell_id = grid.cardinalCellIndex(i,j,k);
                 int c = Kokkos::atomic_fetch_add( &counts(cell_id), 1 );
                 permute( offsets(cell_id) + c ) = p;
+                cells( p - begin ) = cell_id;
             };
         Kokkos::parallel_for( "Cabana::LinkedCellList::build::create_permute",
                               particle_range,
@@ -286,6 +523,18 @@ class LinkedCellList
 
     BinningData<MemorySpace> _bin_data;
     Impl::CartesianGrid<double> _grid;
+    Kokkos::View<int*,KokkosMemorySpace> _counts;
+    OffsetView _offsets;
+    OffsetView _permute;
+
+    // Cell of each particle in the range.
+    Kokkos::View<int*,KokkosMemorySpace> _cells;
+
+    // Buffers for incremental updates which are swapped with the bins.
+    Kokkos::View<int*,KokkosMemorySpace> _next_counts;
+    OffsetView _next_offsets;
+    OffsetView _next_permute;
+    Kokkos::View<int*,KokkosMemorySpace> _next_cells;
 };
 
 //---------------------------------------------------------------------------//
@@ -0,0 +1,327 @@
+/****************************************************************************
+ * Copyright (c) 2018 by the Cabana authors                                 *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef CABANA_MAPPEDFILE_HPP
+#define CABANA_MAPPEDFILE_HPP
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_Types.hpp>
+#include <impl/Cabana_CheckpointFormat.hpp>
+#include <impl/Cabana_PerformanceTraits.hpp>
+
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Cabana
+{
+//---------------------------------------------------------------------------//
+/*!
+  \brief Modes in which a memory-mapped file may be opened.
+
+  ReadOnly maps an existing file which is not modified or resized. The
+  mapping is private such that the data may be modified in memory without
+  changing the file. ReadWrite maps an existing file. Create creates the file
+  or truncates an existing one to be empty.
+*/
+enum class MappedFileMode
+{
+    ReadOnly,
+    ReadWrite,
+    Create
+};
+
+namespace Impl
+{
+//---------------------------------------------------------------------------//
+/*!
+  \class MappedFile
+
+  \brief A memory mapping of an entire file.
+
+  Writable files are mapped shared such that modifications are written to
+  the file. Read-only files are mapped private and copy-on-write. The mapping
+  is released when the object is destroyed. Resizing a file
+  creates a new mapping such that the data in an existing mapping remains
+  accessible for as long as the file is not shrunk below it.
+*/
+class MappedFile
+{
+  public:
+
+    // Open and map a file.
+    MappedFile( const std::string& filename, const MappedFileMode mode )
+        : _fd( -1 )
+        , _data( nullptr )
+        , _size( 0 )
+        , _writable( MappedFileMode::ReadOnly != mode )
+    {
+        int flags = _writable ? O_RDWR : O_RDONLY;
+        if ( MappedFileMode::Create == mode )
+            flags |= O_CREAT | O_TRUNC;
+        _fd = ::open( filename.c_str(), flags, 0644 );
+        if ( _fd < 0 )
+            throw std::runtime_error( "Failed to open mapped file " + filename );
+
+        struct stat file_stat;
+        if ( 0 != ::fstat(_fd,&file_stat) )
+        {
+            ::close( _fd );
+            throw std::runtime_error( "Failed to stat mapped file " + filename );
+        }
+        map( file_stat.st_size );
+    }
+
+    ~MappedFile()
+    {
+        if ( nullptr != _data ) ::munmap( _data, _size );
+        if ( 0 <= _fd ) ::close( _fd );
+    }
+
+    MappedFile( const MappedFile& ) = delete;
+    MappedFile& operator=( const MappedFile& ) = delete;
+
+    // Get the mapped data.
+    char* data() const
+    { return _data; }
+
+    // Get the number of bytes in the file.
+    std::size_t size() const
+    { return _size; }
+
+    // Whether modifications of the mapping are written to the file.
+    bool writable() const
+    { return _writable; }
+
+    // Resize the file and create a new mapping of it. Bytes added to the
+    // file are zero.
+    std::shared_ptr<MappedFile> resize( const std::size_t bytes ) const
+    {
+        if ( !_writable )
+            throw std::runtime_error( "Attempted to resize a read-only mapped file" );
+
+        int fd = ::dup( _fd );
+        if ( fd < 0 || 0 != ::ftruncate(fd,bytes) )
+        {
+            if ( 0 <= fd ) ::close( fd );
+            throw std::runtime_error( "Failed to resize mapped file" );
+        }
+
+        return std::shared_ptr<MappedFile>( new MappedFile(fd,bytes,true) );
+    }
+
+  private:
+
+    MappedFile( const int fd, const std::size_t bytes, const bool writable )
+        : _fd( fd )
+        , _data( nullptr )
+        , _size( 0 )
+        , _writable( writable )
+    {
+        map( bytes );
+    }
+
+    // Map the given number of bytes of the file. Empty files are not mapped.
+    void map( const std::size_t bytes )
+    {
+        _size = bytes;
+        if ( 0 == bytes ) return;
+
+        int flags = _writable ? MAP_SHARED : MAP_PRIVATE;
+        void* ptr =
+            ::mmap( nullptr, bytes, PROT_READ | PROT_WRITE, flags, _fd, 0 );
+        if ( MAP_FAILED == ptr )
+        {
+            ::close( _fd );
+            throw std::runtime_error( "Failed to map file" );
+        }
+        _data = static_cast<char*>( ptr );
+    }
+
+  private:
+
+    int _fd;
+    char* _data;
+    std::size_t _size;
+    bool _writable;
+};
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Impl
+
+//---------------------------------------------------------------------------//
+/*!
+  \class MappedAoSoA
+
+  \brief An AoSoA stored in a memory-mapped checkpoint file.
+
+  \tparam DataTypes (required) Specifically this must be an instance of
+  \c MemberTypes with the data layout of the structs.
+
+  \tparam VectorLength (optional) The vector length of the structs.
+
+  \tparam Alignment (optional) The alignment of the struct member arrays.
+
+  The file has the format written by Cabana::write(). Opening it validates
+  the header against the member types and layout of the AoSoA and then maps
+  the structs in place such that no data is parsed or copied and the data is
+  paged in by the operating system as it is accessed. The AoSoA wraps the
+  mapped structs without owning them. It, and any shallow copies or slices of
+  it, may only be used while this object exists and until it is resized.
+  Files written with a different layout must be re-blocked with
+  Cabana::read() instead.
+
+  Mapping files requires the POSIX memory mapping interface so this header is
+  not included by Cabana_Core.hpp and must be included directly.
+*/
+template<class DataTypes,
+         int VectorLength = Impl::PerformanceTraits<
+             typename MappedHostSpace::kokkos_execution_space>::vector_length,
+         int Alignment = 0>
+class MappedAoSoA
+{
+  public:
+
+    // AoSoA type.
+    using aosoa_type = AoSoA<DataTypes,MappedHostSpace,VectorLength,Alignment>;
+
+    // SoA type.
+    using soa_type = typename aosoa_type::soa_type;
+
+    /*!
+      \brief Open a mapped AoSoA.
+
+      \param filename The checkpoint file to map.
+
+      \param mode The mode in which to open the file. A file opened with
+      MappedFileMode::Create is an empty checkpoint.
+    */
+    explicit MappedAoSoA( const std::string& filename,
+                          const MappedFileMode mode = MappedFileMode::ReadWrite )
+        : _file( std::make_shared<Impl::MappedFile>(filename,mode) )
+        , _data_offset( Impl::checkpointDataOffset<aosoa_type>() )
+    {
+        // Write the header of an empty checkpoint to a new file.
+        if ( MappedFileMode::Create == mode )
+        {
+            Impl::CheckpointHeader header =
+                Impl::checkpointHeader<aosoa_type>( 0, 0 );
+            std::vector<Impl::CheckpointMember> members =
+                Impl::checkpointMembers<aosoa_type>();
+            _file = _file->resize( _data_offset );
+            std::memcpy( _file->data(), &header, sizeof(header) );
+            std::memcpy( _file->data() + sizeof(header), members.data(),
+                         members.size() * sizeof(Impl::CheckpointMember) );
+        }
+
+        // Check the header and the layout of the structs.
+        std::size_t member_bytes =
+            aosoa_type::number_of_members * sizeof(Impl::CheckpointMember);
+        if ( _file->size() < sizeof(Impl::CheckpointHeader) + member_bytes )
+            throw std::runtime_error( "File is not a Cabana checkpoint" );
+        Impl::CheckpointHeader header;
+        std::memcpy( &header, _file->data(), sizeof(header) );
+        Impl::checkCheckpointHeader<aosoa_type>( header );
+        std::vector<Impl::CheckpointMember> members(
+            aosoa_type::number_of_members );
+        std::memcpy( members.data(), _file->data() + sizeof(header),
+                     member_bytes );
+        if ( !Impl::checkCheckpointMembers<aosoa_type>(header,members) ||
+             _data_offset != header.data_offset )
+            throw std::runtime_error(
+                "Mapped checkpoint layout differs from the AoSoA layout" );
+        if ( _file->size() < _data_offset + header.num_soa * sizeof(soa_type) )
+            throw std::runtime_error( "Mapped checkpoint file is truncated" );
+
+        mapAoSoA( header.size );
+    }
+
+    MappedAoSoA( const MappedAoSoA& ) = delete;
+    MappedAoSoA& operator=( const MappedAoSoA& ) = delete;
+
+    /*!
+      \brief Get the mapped AoSoA.
+    */
+    const aosoa_type& aosoa() const
+    { return _aosoa; }
+
+    /*!
+      \brief Get the number of tuples in the AoSoA.
+    */
+    std::size_t size() const
+    { return _aosoa.size(); }
+
+    /*!
+      \brief Resize the AoSoA and record the new size in the file.
+
+      \param n The number of tuples in the AoSoA.
+
+      The file grows if the structs of the AoSoA do not fit. New tuples in a
+      grown file are zero. Growing invalidates the AoSoA previously obtained
+      from this object. A read-only file cannot grow.
+    */
+    void resize( const std::size_t n )
+    {
+        std::size_t num_soa = ( n + VectorLength - 1 ) / VectorLength;
+        if ( _aosoa.capacity() < num_soa * VectorLength )
+            _file = _file->resize( _data_offset + num_soa * sizeof(soa_type) );
+        mapAoSoA( n );
+    }
+
+    /*!
+      \brief Shrink the file to the structs in use. This invalidates the
+      AoSoA previously obtained from this object.
+    */
+    void shrinkToFit()
+    {
+        _file = _file->resize( _data_offset +
+                               _aosoa.numSoA() * sizeof(soa_type) );
+        mapAoSoA( _aosoa.size() );
+    }
+
+  private:
+
+    // Wrap the structs of the mapping in the AoSoA and record its size in
+    // the header.
+    void mapAoSoA( const std::size_t n )
+    {
+        std::size_t bytes =
+            ( (_file->size() - _data_offset) / sizeof(soa_type) ) *
+            sizeof(soa_type);
+        _aosoa = aosoa_type( _file->data() + _data_offset, n, bytes,
+                             VectorLength );
+
+        Impl::CheckpointHeader* header =
+            reinterpret_cast<Impl::CheckpointHeader*>( _file->data() );
+        header->size = _aosoa.size();
+        header->num_soa = _aosoa.numSoA();
+    }
+
+  private:
+
+    std::shared_ptr<Impl::MappedFile> _file;
+    std::size_t _data_offset;
+    aosoa_type _aosoa;
+};
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Cabana
+
+#endif // end CABANA_MAPPEDFILE_HPP
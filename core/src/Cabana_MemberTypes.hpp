@@ -71,6 +71,93 @@ struct MemberTypeAtIndex<I,MemberTypes<Types...> >
         typename MemberTypeAtIndexImpl<I,Types...>::type;
 };
 
+//---------------------------------------------------------------------------//
+/*!
+  \class Stored
+  \brief Member type adapter which stores a member in one type and computes
+  with it in another.
+
+  \tparam StorageType The type of the member data in memory. This may be a
+  multidimensional array (e.g. float[3]).
+
+  \tparam ComputeType The scalar type the member values are converted to
+  when read through a slice. Values written through a slice are converted
+  back to the storage type.
+
+  Using a reduced precision storage type (e.g. Stored<float[3],double>)
+  reduces the memory footprint and bandwidth of a member while kernels
+  operating on slices of it compute in full precision. Tuples, deep copies,
+  and raw slice data always use the storage type.
+*/
+template<typename StorageType, typename ComputeType>
+struct Stored
+{
+    using storage_type = StorageType;
+    using compute_type = ComputeType;
+
+    static_assert( std::is_arithmetic<ComputeType>::value,
+                   "Stored member compute type must be a scalar" );
+};
+
+//---------------------------------------------------------------------------//
+// Static type checker.
+template<class >
+struct is_stored_member : public std::false_type {};
+
+template<typename StorageType, typename ComputeType>
+struct is_stored_member<Stored<StorageType,ComputeType> >
+    : public std::true_type {};
+
+template<typename StorageType, typename ComputeType>
+struct is_stored_member<const Stored<StorageType,ComputeType> >
+    : public std::true_type {};
+
+//---------------------------------------------------------------------------//
+/*!
+  \class MemberDataType
+  \brief Get the type in which a member is stored in memory.
+*/
+template<typename T>
+struct MemberDataType
+{
+    using type = T;
+};
+
+template<typename StorageType, typename ComputeType>
+struct MemberDataType<Stored<StorageType,ComputeType> >
+{
+    using type = StorageType;
+};
+
+template<typename StorageType, typename ComputeType>
+struct MemberDataType<const Stored<StorageType,ComputeType> >
+{
+    using type = const StorageType;
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \class MemberComputeType
+  \brief Get the scalar type in which a member is accessed through a slice.
+*/
+template<typename T>
+struct MemberComputeType
+{
+    using type = typename std::remove_all_extents<T>::type;
+};
+
+template<typename StorageType, typename ComputeType>
+struct MemberComputeType<Stored<StorageType,ComputeType> >
+{
+    using type = ComputeType;
+};
+
+template<typename StorageType, typename ComputeType>
+struct MemberComputeType<const Stored<StorageType,ComputeType> >
+{
+    using type = ComputeType;
+};
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Cabana
@@ -0,0 +1,279 @@
+/****************************************************************************
+ * Copyright (c) 2018 by the Cabana authors                                 *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef CABANA_SCRATCHPOOL_HPP
+#define CABANA_SCRATCHPOOL_HPP
+
+#include <Cabana_Types.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <string>
+#include <stdexcept>
+
+namespace Cabana
+{
+namespace Impl
+{
+//---------------------------------------------------------------------------//
+/*!
+  \class ScratchPool
+
+  \brief A reusable buffer in a memory space from which the temporaries of
+  Cabana algorithms are allocated.
+
+  Allocations are made from the top of the buffer and must be released in
+  the reverse order in which they were made. Allocations which do not fit
+  while others are outstanding are not made from the buffer. The pool records
+  the peak number of bytes requested at once, including those allocations,
+  and grows the buffer to it on the next allocation made when the buffer is
+  not in use. Repeating the same sequence of allocations therefore draws all
+  of them from the buffer. The buffer is released when Kokkos is finalized.
+
+  The pool is not synchronized. Cabana algorithms drawing scratch memory from
+  the same memory space must not be called concurrently from multiple host
+  threads.
+*/
+template<class KokkosMemorySpace>
+class ScratchPool
+{
+  public:
+
+    // Allocations are padded to this many bytes to preserve the alignment of
+    // the buffer.
+    static constexpr std::size_t alignment = 128;
+
+    // Get the pool of the memory space.
+    static ScratchPool& instance()
+    {
+        static ScratchPool pool;
+        return pool;
+    }
+
+    // Get the number of bytes in the buffer.
+    std::size_t capacity() const
+    { return _buffer.extent(0); }
+
+    // Get the number of bytes currently allocated from the buffer.
+    std::size_t used() const
+    { return _top; }
+
+    // Get the peak number of bytes requested at once.
+    std::size_t peak() const
+    { return _peak; }
+
+    // Get the number of allocations which did not fit in the buffer.
+    std::size_t numFallback() const
+    { return _num_fallback; }
+
+    // Grow the buffer to at least the given number of bytes.
+    void reserve( const std::size_t bytes )
+    {
+        if ( bytes <= capacity() ) return;
+
+        if ( 0 < _top )
+            throw std::runtime_error(
+                "Attempted to resize a scratch pool which is in use" );
+
+        if ( !_hook_registered )
+        {
+            Kokkos::push_finalize_hook( [](){ instance().release(); } );
+            _hook_registered = true;
+        }
+
+        _buffer = buffer_type();
+        _buffer = buffer_type(
+            Kokkos::ViewAllocateWithoutInitializing("Cabana::ScratchPool"),
+            bytes );
+    }
+
+    // Release the buffer.
+    void release()
+    {
+        if ( 0 < _top )
+            throw std::runtime_error(
+                "Attempted to release a scratch pool which is in use" );
+        _buffer = buffer_type();
+        _peak = _requested;
+    }
+
+    // Allocate the given number of bytes from the top of the buffer. Returns
+    // nullptr if the allocation does not fit in the buffer and the buffer
+    // cannot grow because other allocations are outstanding. Every call must
+    // be matched by a call to deallocate() whether or not it succeeded.
+    char* allocate( const std::size_t bytes )
+    {
+        std::size_t padded = paddedBytes( bytes );
+        if ( 0 == padded ) return nullptr;
+        _requested += padded;
+        if ( _peak < _requested ) _peak = _requested;
+        if ( 0 == _top ) reserve( _peak );
+        if ( capacity() < _top + padded )
+        {
+            ++_num_fallback;
+            return nullptr;
+        }
+        char* ptr = _buffer.data() + _top;
+        _top += padded;
+        return ptr;
+    }
+
+    // Release an allocation of the given number of bytes. Allocations made
+    // from the buffer are released from its top.
+    void deallocate( const std::size_t bytes, const bool from_buffer )
+    {
+        std::size_t padded = paddedBytes( bytes );
+        _requested -= padded;
+        if ( from_buffer ) _top -= padded;
+    }
+
+  private:
+
+    using buffer_type = Kokkos::View<char*,KokkosMemorySpace>;
+
+    ScratchPool()
+        : _top( 0 )
+        , _requested( 0 )
+        , _peak( 0 )
+        , _num_fallback( 0 )
+        , _hook_registered( false )
+    {}
+
+    static std::size_t paddedBytes( const std::size_t bytes )
+    {
+        return ( (bytes + alignment - 1) / alignment ) * alignment;
+    }
+
+  private:
+
+    buffer_type _buffer;
+    std::size_t _top;
+    std::size_t _requested;
+    std::size_t _peak;
+    std::size_t _num_fallback;
+    bool _hook_registered;
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \class ScratchView
+
+  \brief A temporary 1D view allocated from the scratch pool of a memory
+  space.
+
+  The memory is returned to the pool when the object is destroyed so the
+  view must not be used after that. If the pool cannot provide the memory the
+  view is allocated directly instead. The view is not initialized.
+*/
+template<class T, class KokkosMemorySpace>
+class ScratchView
+{
+  public:
+
+    using view_type =
+        Kokkos::View<T*,KokkosMemorySpace,Kokkos::MemoryUnmanaged>;
+
+    ScratchView( const std::string& label, const std::size_t n )
+        : _bytes( n * sizeof(T) )
+        , _ptr( ScratchPool<KokkosMemorySpace>::instance().allocate(_bytes) )
+    {
+        if ( nullptr != _ptr )
+        {
+            _view = view_type( reinterpret_cast<T*>(_ptr), n );
+        }
+        else
+        {
+            _fallback = Kokkos::View<T*,KokkosMemorySpace>(
+                Kokkos::ViewAllocateWithoutInitializing(label), n );
+            _view = _fallback;
+        }
+    }
+
+    ~ScratchView()
+    {
+        ScratchPool<KokkosMemorySpace>::instance().deallocate(
+            _bytes, nullptr != _ptr );
+    }
+
+    ScratchView( const ScratchView& ) = delete;
+    ScratchView& operator=( const ScratchView& ) = delete;
+
+    // Get the view.
+    const view_type& view() const
+    { return _view; }
+
+  private:
+
+    std::size_t _bytes;
+    char* _ptr;
+    view_type _view;
+    Kokkos::View<T*,KokkosMemorySpace> _fallback;
+};
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Impl
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Reserve scratch memory for the temporaries of Cabana algorithms in a
+  memory space.
+
+  \tparam MemorySpace The memory space of the scratch memory.
+
+  \param bytes The number of bytes to reserve.
+
+  Algorithms such as permute() and sorting by a slice draw their temporaries
+  from a pool in the memory space of the data instead of allocating them on
+  every call. The pool grows on demand to the peak memory requested at once,
+  including by nested algorithms, so reserving memory up front is only needed
+  to avoid allocations in the first call.
+*/
+template<class MemorySpace>
+void reserveScratch( const std::size_t bytes )
+{
+    Impl::ScratchPool<typename MemorySpace::kokkos_memory_space>::instance()
+        .reserve( bytes );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Get the number of bytes of scratch memory in a memory space.
+
+  \tparam MemorySpace The memory space of the scratch memory.
+
+  \return The number of bytes of scratch memory.
+*/
+template<class MemorySpace>
+std::size_t scratchCapacity()
+{
+    return Impl::ScratchPool<
+        typename MemorySpace::kokkos_memory_space>::instance().capacity();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Release the scratch memory in a memory space.
+
+  \tparam MemorySpace The memory space of the scratch memory.
+*/
+template<class MemorySpace>
+void releaseScratch()
+{
+    Impl::ScratchPool<typename MemorySpace::kokkos_memory_space>::instance()
+        .release();
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Cabana
+
+#endif // end CABANA_SCRATCHPOOL_HPP
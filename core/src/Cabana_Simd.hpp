@@ -0,0 +1,184 @@
+/****************************************************************************
+ * Copyright (c) 2018 by the Cabana authors                                 *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef CABANA_SIMD_HPP
+#define CABANA_SIMD_HPP
+
+#include <Cabana_Macros.hpp>
+
+#include <cstdlib>
+#include <type_traits>
+
+namespace Cabana
+{
+namespace Impl
+{
+//---------------------------------------------------------------------------//
+// Alignment of a pack. Packs whose size is a power of two are aligned to
+// their size, up to a cache line, such that they map onto vector registers.
+template<typename T, int N>
+struct SimdAlignment
+{
+    static constexpr std::size_t bytes = sizeof(T) * N;
+    static constexpr std::size_t value =
+        ( 0 != (bytes & (bytes - 1)) ) ? alignof(T) :
+        ( (bytes < 64) ? ((bytes < alignof(T)) ? alignof(T) : bytes) : 64 );
+};
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Impl
+
+//---------------------------------------------------------------------------//
+/*!
+  \class Simd
+
+  \brief A pack of N values operated on element-wise.
+
+  A pack holds the values of one member component over the inner array of a
+  struct such that arithmetic on packs is written as fixed-length loops
+  which the compiler maps directly onto vector instructions. Packs are
+  loaded from and stored to slices with Slice::loadSimd() and
+  Slice::storeSimd().
+
+  \tparam T The value type.
+
+  \tparam N The number of values in the pack.
+*/
+template<typename T, int N>
+struct Simd
+{
+    using value_type = T;
+
+    static constexpr int size = N;
+
+    alignas(Impl::SimdAlignment<T,N>::value) T _data[N];
+
+    // Default constructor. The values are not initialized.
+    Simd() = default;
+
+    // Broadcast a value to all elements.
+    CABANA_FORCEINLINE_FUNCTION
+    Simd( const T& value )
+    {
+        for ( int i = 0; i < N; ++i ) _data[i] = value;
+    }
+
+    // Element access.
+    CABANA_FORCEINLINE_FUNCTION
+    T& operator[]( const int i ) { return _data[i]; }
+
+    CABANA_FORCEINLINE_FUNCTION
+    const T& operator[]( const int i ) const { return _data[i]; }
+
+    // Element-wise compound assignment.
+    CABANA_FORCEINLINE_FUNCTION
+    Simd& operator+=( const Simd& rhs )
+    {
+        for ( int i = 0; i < N; ++i ) _data[i] += rhs._data[i];
+        return *this;
+    }
+
+    CABANA_FORCEINLINE_FUNCTION
+    Simd& operator-=( const Simd& rhs )
+    {
+        for ( int i = 0; i < N; ++i ) _data[i] -= rhs._data[i];
+        return *this;
+    }
+
+    CABANA_FORCEINLINE_FUNCTION
+    Simd& operator*=( const Simd& rhs )
+    {
+        for ( int i = 0; i < N; ++i ) _data[i] *= rhs._data[i];
+        return *this;
+    }
+
+    CABANA_FORCEINLINE_FUNCTION
+    Simd& operator/=( const Simd& rhs )
+    {
+        for ( int i = 0; i < N; ++i ) _data[i] /= rhs._data[i];
+        return *this;
+    }
+};
+
+//---------------------------------------------------------------------------//
+// Element-wise arithmetic. Scalars are broadcast to all elements.
+//---------------------------------------------------------------------------//
+template<typename T, int N>
+CABANA_FORCEINLINE_FUNCTION
+Simd<T,N> operator+( Simd<T,N> lhs, const Simd<T,N>& rhs )
+{ return lhs += rhs; }
+
+template<typename T, int N>
+CABANA_FORCEINLINE_FUNCTION
+Simd<T,N> operator-( Simd<T,N> lhs, const Simd<T,N>& rhs )
+{ return lhs -= rhs; }
+
+template<typename T, int N>
+CABANA_FORCEINLINE_FUNCTION
+Simd<T,N> operator*( Simd<T,N> lhs, const Simd<T,N>& rhs )
+{ return lhs *= rhs; }
+
+template<typename T, int N>
+CABANA_FORCEINLINE_FUNCTION
+Simd<T,N> operator/( Simd<T,N> lhs, const Simd<T,N>& rhs )
+{ return lhs /= rhs; }
+
+template<typename T, int N>
+CABANA_FORCEINLINE_FUNCTION
+Simd<T,N> operator+( Simd<T,N> lhs, const T& rhs )
+{ return lhs += Simd<T,N>( rhs ); }
+
+template<typename T, int N>
+CABANA_FORCEINLINE_FUNCTION
+Simd<T,N> operator-( Simd<T,N> lhs, const T& rhs )
+{ return lhs -= Simd<T,N>( rhs ); }
+
+template<typename T, int N>
+CABANA_FORCEINLINE_FUNCTION
+Simd<T,N> operator*( Simd<T,N> lhs, const T& rhs )
+{ return lhs *= Simd<T,N>( rhs ); }
+
+template<typename T, int N>
+CABANA_FORCEINLINE_FUNCTION
+Simd<T,N> operator/( Simd<T,N> lhs, const T& rhs )
+{ return lhs /= Simd<T,N>( rhs ); }
+
+template<typename T, int N>
+CABANA_FORCEINLINE_FUNCTION
+Simd<T,N> operator+( const T& lhs, const Simd<T,N>& rhs )
+{ return Simd<T,N>( lhs ) += rhs; }
+
+template<typename T, int N>
+CABANA_FORCEINLINE_FUNCTION
+Simd<T,N> operator-( const T& lhs, const Simd<T,N>& rhs )
+{ return Simd<T,N>( lhs ) -= rhs; }
+
+template<typename T, int N>
+CABANA_FORCEINLINE_FUNCTION
+Simd<T,N> operator*( const T& lhs, const Simd<T,N>& rhs )
+{ return Simd<T,N>( lhs ) *= rhs; }
+
+template<typename T, int N>
+CABANA_FORCEINLINE_FUNCTION
+Simd<T,N> operator/( const T& lhs, const Simd<T,N>& rhs )
+{ return Simd<T,N>( lhs ) /= rhs; }
+
+template<typename T, int N>
+CABANA_FORCEINLINE_FUNCTION
+Simd<T,N> operator-( const Simd<T,N>& rhs )
+{ return Simd<T,N>( T(0) ) -= rhs; }
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Cabana
+
+#endif // end CABANA_SIMD_HPP
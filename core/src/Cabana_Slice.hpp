@@ -14,6 +14,8 @@
 
 #include <Cabana_Types.hpp>
 #include <Cabana_Macros.hpp>
+#include <Cabana_MemberTypes.hpp>
+#include <Cabana_Simd.hpp>
 #include <impl/Cabana_Index.hpp>
 #include <impl/Cabana_TypeTraits.hpp>
 
@@ -139,6 +141,99 @@ struct KokkosViewWrapper
     }
 };
 
+//---------------------------------------------------------------------------//
+/*!
+  \brief Reference to a member value stored in a different type than the one
+  it is computed with.
+
+  Reading the reference converts the stored value to the compute type and
+  assigning to it converts the assigned value back to the storage type.
+*/
+template<typename Reference, typename ComputeType>
+class StoredReference
+{
+  public:
+
+    using storage_type = typename std::remove_cv<
+        typename std::remove_reference<Reference>::type>::type;
+    using compute_type = ComputeType;
+
+    CABANA_FORCEINLINE_FUNCTION
+    StoredReference( Reference ref )
+        : _ref( ref )
+    {}
+
+    CABANA_FORCEINLINE_FUNCTION
+    operator compute_type() const
+    { return static_cast<compute_type>( _ref ); }
+
+    CABANA_FORCEINLINE_FUNCTION
+    const StoredReference& operator=( const compute_type& value ) const
+    {
+        _ref = static_cast<storage_type>( value );
+        return *this;
+    }
+
+    CABANA_FORCEINLINE_FUNCTION
+    const StoredReference& operator=( const StoredReference& rhs ) const
+    { return *this = static_cast<compute_type>( rhs ); }
+
+    CABANA_FORCEINLINE_FUNCTION
+    const StoredReference& operator+=( const compute_type& value ) const
+    { return *this = static_cast<compute_type>( *this ) + value; }
+
+    CABANA_FORCEINLINE_FUNCTION
+    const StoredReference& operator-=( const compute_type& value ) const
+    { return *this = static_cast<compute_type>( *this ) - value; }
+
+    CABANA_FORCEINLINE_FUNCTION
+    const StoredReference& operator*=( const compute_type& value ) const
+    { return *this = static_cast<compute_type>( *this ) * value; }
+
+    CABANA_FORCEINLINE_FUNCTION
+    const StoredReference& operator/=( const compute_type& value ) const
+    { return *this = static_cast<compute_type>( *this ) / value; }
+
+  private:
+
+    Reference _ref;
+};
+
+//---------------------------------------------------------------------------//
+// Scalar member type of a single component of a multidimensional member.
+template<typename T>
+struct ComponentDataType
+{
+    using type = typename std::remove_all_extents<T>::type;
+};
+
+template<typename StorageType, typename ComputeType>
+struct ComponentDataType<Stored<StorageType,ComputeType> >
+{
+    using type =
+        Stored<typename std::remove_all_extents<StorageType>::type,ComputeType>;
+};
+
+template<typename StorageType, typename ComputeType>
+struct ComponentDataType<const Stored<StorageType,ComputeType> >
+{
+    using type = const
+        Stored<typename std::remove_all_extents<StorageType>::type,ComputeType>;
+};
+
+//---------------------------------------------------------------------------//
+// Alignment of the component arrays of a member. The component arrays keep
+// the alignment of the member arrays only if the component array size is a
+// multiple of it.
+template<typename ValueType, int VectorLength, int Alignment>
+struct ComponentAlignment
+{
+    static constexpr int value =
+        ( 0 < Alignment &&
+          0 == (sizeof(ValueType) * VectorLength) % std::size_t(Alignment) )
+        ? Alignment : 0;
+};
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Impl
@@ -149,12 +244,27 @@ struct KokkosViewWrapper
 
   \brief A slice of an array-of-structs-of-arrays with data access to a single
   multidimensional member.
+
+  The alignment is the alignment in bytes of the member arrays in the
+  structs. The underlying Kokkos view is only marked as aligned if this is at
+  least the Kokkos memory alignment.
+
+  If the data type is a Stored member then the slice accesses values in the
+  compute type of the member while the raw data is in the storage type. In
+  this case the access operators return a reference proxy which converts on
+  read and write. Updates through the proxy are not atomic.
+
+  If the data type is const then the slice is read-only. Read-only slices do
+  not restrict aliasing such that they may be used together with other slices
+  of the same data. They are constructed from slices of the non-const data
+  type.
 */
 //---------------------------------------------------------------------------//
 template<typename DataType,
          typename MemorySpace,
          typename MemoryAccessType,
          int VectorLength,
+         int Alignment = 0,
          typename std::enable_if<
              (is_memory_space<MemorySpace>::value &&
               is_memory_access_tag<MemoryAccessType>::value &&
@@ -165,7 +275,7 @@ class Slice
 
     // Slice type.
     using slice_type =
-        Slice<DataType,MemorySpace,MemoryAccessType,VectorLength>;
+        Slice<DataType,MemorySpace,MemoryAccessType,VectorLength,Alignment>;
 
     // Cabana memory space.
     using memory_space = MemorySpace;
@@ -176,45 +286,113 @@ class Slice
     // Vector length.
     static constexpr int vector_length = VectorLength;
 
+    // Alignment of the member arrays in bytes.
+    static constexpr int alignment = Alignment;
+
+    // Whether the member arrays are aligned to the Kokkos memory alignment.
+    static constexpr bool is_aligned =
+        ( Alignment >= int(Kokkos::Impl::MEMORY_ALIGNMENT) );
+
     // Index type.
     using index_type = Impl::Index<vector_length>;
 
     // Maximum supported rank.
     static constexpr int max_supported_rank = 3;
 
+    // Member data type as declared.
+    using member_slice_data_type = DataType;
+
+    // Member data type in memory.
+    using data_type = typename MemberDataType<DataType>::type;
+
+    // Member scalar type used for computation.
+    using compute_type = typename MemberComputeType<DataType>::type;
+
+    // Whether the member is stored in a different type than it is computed
+    // with.
+    static constexpr bool is_stored = is_stored_member<DataType>::value;
+
+    // Whether the slice is read-only.
+    static constexpr bool is_read_only =
+        std::is_const<typename std::remove_all_extents<data_type>::type>::value;
+
     // Kokkos view wrapper.
-    using view_wrapper = Impl::KokkosViewWrapper<DataType,vector_length>;
+    using view_wrapper = Impl::KokkosViewWrapper<data_type,vector_length>;
 
     // Kokkos view type.
     using kokkos_view =
         Kokkos::View<typename view_wrapper::data_type,
                      Kokkos::LayoutStride,
                      typename MemorySpace::kokkos_memory_space,
-                     typename MemoryAccessType::kokkos_memory_traits>;
-
-    // View type aliases.
-    using reference_type = typename kokkos_view::reference_type;
-    using value_type = typename kokkos_view::value_type;
+                     typename std::conditional<
+                         is_read_only,
+                         typename std::conditional<
+                             is_aligned,
+                             typename MemoryAccessType::kokkos_const_aligned_memory_traits,
+                             typename MemoryAccessType::kokkos_const_memory_traits
+                             >::type,
+                         typename std::conditional<
+                             is_aligned,
+                             typename MemoryAccessType::kokkos_aligned_memory_traits,
+                             typename MemoryAccessType::kokkos_memory_traits
+                             >::type
+                         >::type>;
+
+    // View type aliases. Stored members are accessed in the compute type
+    // and read-only stored members are read by value.
+    using reference_type = typename std::conditional<
+        is_stored,
+        typename std::conditional<
+            is_read_only,
+            compute_type,
+            Impl::StoredReference<typename kokkos_view::reference_type,
+                                  compute_type> >::type,
+        typename kokkos_view::reference_type>::type;
+    using value_type = typename std::conditional<
+        is_stored,
+        compute_type,
+        typename kokkos_view::value_type>::type;
     using pointer_type = typename kokkos_view::pointer_type;
     using kokkos_memory_space = typename kokkos_view::memory_space;
     using kokkos_execution_space = typename kokkos_view::execution_space;
     using kokkos_device_type = typename kokkos_view::device_type;
 
+    // Pack type holding one member component over the inner array of a
+    // struct.
+    using simd_type =
+        Simd<typename std::remove_const<value_type>::type,vector_length>;
+
     // Compatible memory access slice types.
     using default_access_slice =
-        Slice<DataType,MemorySpace,DefaultAccessMemory,VectorLength>;
+        Slice<DataType,MemorySpace,DefaultAccessMemory,VectorLength,Alignment>;
     using atomic_access_slice =
-        Slice<DataType,MemorySpace,AtomicAccessMemory,VectorLength>;
+        Slice<DataType,MemorySpace,AtomicAccessMemory,VectorLength,Alignment>;
     using random_access_slice =
-        Slice<DataType,MemorySpace,RandomAccessMemory,VectorLength>;
+        Slice<DataType,MemorySpace,RandomAccessMemory,VectorLength,Alignment>;
 
     // Declare slices of different memory access types to be friends.
-    friend class Slice<DataType,MemorySpace,DefaultAccessMemory,VectorLength>;
-    friend class Slice<DataType,MemorySpace,AtomicAccessMemory,VectorLength>;
-    friend class Slice<DataType,MemorySpace,RandomAccessMemory,VectorLength>;
+    friend class
+    Slice<DataType,MemorySpace,DefaultAccessMemory,VectorLength,Alignment>;
+    friend class
+    Slice<DataType,MemorySpace,AtomicAccessMemory,VectorLength,Alignment>;
+    friend class
+    Slice<DataType,MemorySpace,RandomAccessMemory,VectorLength,Alignment>;
+
+    // Read-only slice types and the slice types they are constructed from.
+    using const_data_type = typename std::add_const<DataType>::type;
+    using non_const_data_type = typename std::remove_const<DataType>::type;
+    using const_slice =
+        Slice<const_data_type,MemorySpace,MemoryAccessType,VectorLength,Alignment>;
+
+    friend class
+    Slice<const_data_type,MemorySpace,DefaultAccessMemory,VectorLength,Alignment>;
+    friend class
+    Slice<const_data_type,MemorySpace,AtomicAccessMemory,VectorLength,Alignment>;
+    friend class
+    Slice<const_data_type,MemorySpace,RandomAccessMemory,VectorLength,Alignment>;
 
     // Data rank.
-    enum { Rank = std::rank<DataType>::value };
+    enum { Rank = std::rank<data_type>::value };
 
   public:
 
@@ -249,7 +427,7 @@ class Slice
       space.
      */
     template<class MAT>
-    Slice( const Slice<DataType,MemorySpace,MAT,VectorLength>& rhs )
+    Slice( const Slice<DataType,MemorySpace,MAT,VectorLength,Alignment>& rhs )
         : _view( rhs._view )
         , _size( rhs._size )
     {}
@@ -264,7 +442,40 @@ class Slice
       space.
      */
     template<class MAT>
-    Slice& operator=( const Slice<DataType,MemorySpace,MAT,VectorLength>& rhs )
+    Slice& operator=(
+        const Slice<DataType,MemorySpace,MAT,VectorLength,Alignment>& rhs )
+    {
+        _view = rhs._view;
+        _size = rhs._size;
+        return *this;
+    }
+
+    /*!
+      \brief Shallow copy constructor of a read-only slice from a slice of the
+      non-const data type with any memory access type.
+      \tparam MAT Memory access type.
+      \param rhs The slice to shallow copy.
+     */
+    template<class MAT, class DT = DataType>
+    Slice( const Slice<non_const_data_type,MemorySpace,MAT,
+                       VectorLength,Alignment>& rhs,
+           typename std::enable_if<std::is_const<DT>::value,int>::type = 0 )
+        : _view( rhs._view )
+        , _size( rhs._size )
+    {}
+
+    /*!
+      \brief Assignment of a slice of the non-const data type to a read-only
+      slice.
+      \tparam MAT Memory access type.
+      \param rhs The slice to shallow copy.
+      \return A reference to this slice.
+     */
+    template<class MAT, class DT = DataType>
+    typename std::enable_if<std::is_const<DT>::value,Slice&>::type
+    operator=(
+        const Slice<non_const_data_type,MemorySpace,MAT,
+                    VectorLength,Alignment>& rhs )
     {
         _view = rhs._view;
         _size = rhs._size;
@@ -306,12 +517,12 @@ class Slice
     // Rank 0
     template<typename S,
              typename A,
-             typename U = DataType>
+             typename U = data_type>
     CABANA_FORCEINLINE_FUNCTION
     typename std::enable_if<(0==std::rank<U>::value &&
                              std::is_integral<S>::value &&
                              std::is_integral<A>::value &&
-                             std::is_same<U,DataType>::value),
+                             std::is_same<U,data_type>::value),
                             reference_type>::type
     access( const S& s,
             const A& a ) const
@@ -321,13 +532,13 @@ class Slice
     template<typename S,
              typename A,
              typename D0,
-             typename U = DataType>
+             typename U = data_type>
     CABANA_FORCEINLINE_FUNCTION
     typename std::enable_if<(1==std::rank<U>::value &&
                              std::is_integral<S>::value &&
                              std::is_integral<A>::value &&
                              std::is_integral<D0>::value &&
-                             std::is_same<U,DataType>::value),
+                             std::is_same<U,data_type>::value),
                             reference_type>::type
     access( const S& s,
             const A& a,
@@ -339,14 +550,14 @@ class Slice
              typename A,
              typename D0,
              typename D1,
-             typename U = DataType>
+             typename U = data_type>
     CABANA_FORCEINLINE_FUNCTION
     typename std::enable_if<(2==std::rank<U>::value &&
                              std::is_integral<S>::value &&
                              std::is_integral<A>::value &&
                              std::is_integral<D0>::value &&
                              std::is_integral<D1>::value &&
-                             std::is_same<U,DataType>::value),
+                             std::is_same<U,data_type>::value),
                             reference_type>::type
     access( const S& s,
             const A& a,
@@ -360,7 +571,7 @@ class Slice
              typename D0,
              typename D1,
              typename D2,
-             typename U = DataType>
+             typename U = data_type>
     CABANA_FORCEINLINE_FUNCTION
     typename std::enable_if<(3==std::rank<U>::value &&
                              std::is_integral<S>::value &&
@@ -368,7 +579,7 @@ class Slice
                              std::is_integral<D0>::value &&
                              std::is_integral<D1>::value &&
                              std::is_integral<D2>::value &&
-                             std::is_same<U,DataType>::value),
+                             std::is_same<U,data_type>::value),
                             reference_type>::type
     access( const S& s,
             const A& a,
@@ -382,11 +593,11 @@ class Slice
 
     // Rank 0
     template<typename I,
-             typename U = DataType>
+             typename U = data_type>
     CABANA_FORCEINLINE_FUNCTION
     typename std::enable_if<(0==std::rank<U>::value &&
                              std::is_integral<I>::value &&
-                             std::is_same<U,DataType>::value),
+                             std::is_same<U,data_type>::value),
                             reference_type>::type
     operator()( const I& i ) const
     { return access( index_type::s(i), index_type::a(i) ); }
@@ -394,12 +605,12 @@ class Slice
     // Rank 1
     template<typename I,
              typename D0,
-             typename U = DataType>
+             typename U = data_type>
     CABANA_FORCEINLINE_FUNCTION
     typename std::enable_if<(1==std::rank<U>::value &&
                              std::is_integral<I>::value &&
                              std::is_integral<D0>::value &&
-                             std::is_same<U,DataType>::value),
+                             std::is_same<U,data_type>::value),
                             reference_type>::type
     operator()( const I& i,
                 const D0& d0 ) const
@@ -409,13 +620,13 @@ class Slice
     template<typename I,
              typename D0,
              typename D1,
-             typename U = DataType>
+             typename U = data_type>
     CABANA_FORCEINLINE_FUNCTION
     typename std::enable_if<(2==std::rank<U>::value &&
                              std::is_integral<I>::value &&
                              std::is_integral<D0>::value &&
                              std::is_integral<D1>::value &&
-                             std::is_same<U,DataType>::value),
+                             std::is_same<U,data_type>::value),
                             reference_type>::type
     operator()( const I& i,
                 const D0& d0,
@@ -427,14 +638,14 @@ class Slice
              typename D0,
              typename D1,
              typename D2,
-             typename U = DataType>
+             typename U = data_type>
     CABANA_FORCEINLINE_FUNCTION
     typename std::enable_if<(3==std::rank<U>::value &&
                              std::is_integral<I>::value &&
                              std::is_integral<D0>::value &&
                              std::is_integral<D1>::value &&
                              std::is_integral<D2>::value &&
-                             std::is_same<U,DataType>::value),
+                             std::is_same<U,data_type>::value),
                             reference_type>::type
     operator()( const I& i,
                 const D0& d0,
@@ -442,6 +653,164 @@ class Slice
                 const D2& d2 ) const
     { return access( index_type::s(i), index_type::a(i), d0, d1, d2 ); }
 
+    // -------------------------------
+    // Pack access.
+
+    /*!
+      \brief Load a member component over the inner array of a struct as a
+      pack. Lanes past the end of the slice in the last struct are zero.
+      \param s The struct index.
+      \param d0,... The member component indices.
+      \return The pack.
+    */
+    // Rank 0
+    template<typename S,
+             typename U = data_type>
+    CABANA_FORCEINLINE_FUNCTION
+    typename std::enable_if<(0==std::rank<U>::value &&
+                             std::is_integral<S>::value &&
+                             std::is_same<U,data_type>::value),
+                            simd_type>::type
+    loadSimd( const S& s ) const
+    { return loadArray( s, s*_view.stride(0) ); }
+
+    // Rank 1
+    template<typename S,
+             typename D0,
+             typename U = data_type>
+    CABANA_FORCEINLINE_FUNCTION
+    typename std::enable_if<(1==std::rank<U>::value &&
+                             std::is_integral<S>::value &&
+                             std::is_integral<D0>::value &&
+                             std::is_same<U,data_type>::value),
+                            simd_type>::type
+    loadSimd( const S& s,
+              const D0& d0 ) const
+    { return loadArray( s, s*_view.stride(0) + d0*_view.stride(2) ); }
+
+    // Rank 2
+    template<typename S,
+             typename D0,
+             typename D1,
+             typename U = data_type>
+    CABANA_FORCEINLINE_FUNCTION
+    typename std::enable_if<(2==std::rank<U>::value &&
+                             std::is_integral<S>::value &&
+                             std::is_integral<D0>::value &&
+                             std::is_integral<D1>::value &&
+                             std::is_same<U,data_type>::value),
+                            simd_type>::type
+    loadSimd( const S& s,
+              const D0& d0,
+              const D1& d1 ) const
+    {
+        return loadArray( s, s*_view.stride(0) + d0*_view.stride(2) +
+                          d1*_view.stride(3) );
+    }
+
+    // Rank 3
+    template<typename S,
+             typename D0,
+             typename D1,
+             typename D2,
+             typename U = data_type>
+    CABANA_FORCEINLINE_FUNCTION
+    typename std::enable_if<(3==std::rank<U>::value &&
+                             std::is_integral<S>::value &&
+                             std::is_integral<D0>::value &&
+                             std::is_integral<D1>::value &&
+                             std::is_integral<D2>::value &&
+                             std::is_same<U,data_type>::value),
+                            simd_type>::type
+    loadSimd( const S& s,
+              const D0& d0,
+              const D1& d1,
+              const D2& d2 ) const
+    {
+        return loadArray( s, s*_view.stride(0) + d0*_view.stride(2) +
+                          d1*_view.stride(3) + d2*_view.stride(4) );
+    }
+
+    /*!
+      \brief Store a pack to a member component over the inner array of a
+      struct. Lanes past the end of the slice in the last struct are not
+      written. Stores are not atomic, regardless of the memory access type.
+      \param s The struct index.
+      \param d0,... The member component indices.
+      \param pack The pack to store.
+    */
+    // Rank 0
+    template<typename S,
+             typename U = data_type>
+    CABANA_FORCEINLINE_FUNCTION
+    typename std::enable_if<(0==std::rank<U>::value &&
+                             std::is_integral<S>::value &&
+                             std::is_same<U,data_type>::value),
+                            void>::type
+    storeSimd( const S& s,
+               const simd_type& pack ) const
+    { storeArray( s, s*_view.stride(0), pack ); }
+
+    // Rank 1
+    template<typename S,
+             typename D0,
+             typename U = data_type>
+    CABANA_FORCEINLINE_FUNCTION
+    typename std::enable_if<(1==std::rank<U>::value &&
+                             std::is_integral<S>::value &&
+                             std::is_integral<D0>::value &&
+                             std::is_same<U,data_type>::value),
+                            void>::type
+    storeSimd( const S& s,
+               const D0& d0,
+               const simd_type& pack ) const
+    { storeArray( s, s*_view.stride(0) + d0*_view.stride(2), pack ); }
+
+    // Rank 2
+    template<typename S,
+             typename D0,
+             typename D1,
+             typename U = data_type>
+    CABANA_FORCEINLINE_FUNCTION
+    typename std::enable_if<(2==std::rank<U>::value &&
+                             std::is_integral<S>::value &&
+                             std::is_integral<D0>::value &&
+                             std::is_integral<D1>::value &&
+                             std::is_same<U,data_type>::value),
+                            void>::type
+    storeSimd( const S& s,
+               const D0& d0,
+               const D1& d1,
+               const simd_type& pack ) const
+    {
+        storeArray( s, s*_view.stride(0) + d0*_view.stride(2) +
+                    d1*_view.stride(3), pack );
+    }
+
+    // Rank 3
+    template<typename S,
+             typename D0,
+             typename D1,
+             typename D2,
+             typename U = data_type>
+    CABANA_FORCEINLINE_FUNCTION
+    typename std::enable_if<(3==std::rank<U>::value &&
+                             std::is_integral<S>::value &&
+                             std::is_integral<D0>::value &&
+                             std::is_integral<D1>::value &&
+                             std::is_integral<D2>::value &&
+                             std::is_same<U,data_type>::value),
+                            void>::type
+    storeSimd( const S& s,
+               const D0& d0,
+               const D1& d1,
+               const D2& d2,
+               const simd_type& pack ) const
+    {
+        storeArray( s, s*_view.stride(0) + d0*_view.stride(2) +
+                    d1*_view.stride(3) + d2*_view.stride(4), pack );
+    }
+
     // -------------------------------
     // Raw data access.
 
@@ -484,6 +853,63 @@ class Slice
     std::size_t stride( const std::size_t d ) const
     { return _view.stride(d); }
 
+  private:
+
+    // Get the number of tuples of the slice in a given struct.
+    CABANA_FORCEINLINE_FUNCTION
+    int validLanes( const std::size_t s ) const
+    {
+        const std::size_t begin = s * vector_length;
+        return ( _size >= begin + vector_length ) ? vector_length :
+            ( (_size > begin) ? int(_size - begin) : 0 );
+    }
+
+    // Load the inner array starting at the given offset. Full arrays are
+    // loaded with a fixed trip count such that the loop is vectorized.
+    CABANA_FORCEINLINE_FUNCTION
+    simd_type loadArray( const std::size_t s, const std::size_t offset ) const
+    {
+        using simd_value_type = typename simd_type::value_type;
+        simd_type pack;
+        const pointer_type array = _view.data() + offset;
+        const int n = validLanes( s );
+        if ( vector_length == n )
+        {
+            for ( int a = 0; a < vector_length; ++a )
+                pack[a] = static_cast<simd_value_type>( array[a] );
+        }
+        else
+        {
+            for ( int a = 0; a < vector_length; ++a )
+                pack[a] = ( a < n )
+                          ? static_cast<simd_value_type>( array[a] )
+                          : simd_value_type( 0 );
+        }
+        return pack;
+    }
+
+    // Store the inner array starting at the given offset.
+    CABANA_FORCEINLINE_FUNCTION
+    void storeArray( const std::size_t s,
+                     const std::size_t offset,
+                     const simd_type& pack ) const
+    {
+        using storage_type = typename std::remove_all_extents<data_type>::type;
+        static_assert( !is_read_only, "Cannot store to a read-only slice" );
+        const pointer_type array = _view.data() + offset;
+        const int n = validLanes( s );
+        if ( vector_length == n )
+        {
+            for ( int a = 0; a < vector_length; ++a )
+                array[a] = static_cast<storage_type>( pack[a] );
+        }
+        else
+        {
+            for ( int a = 0; a < n; ++a )
+                array[a] = static_cast<storage_type>( pack[a] );
+        }
+    }
+
   private:
 
     // The data view. This view is unmanaged and has access traits specified
@@ -504,23 +930,95 @@ struct is_slice : public std::false_type {};
 template<typename DataType,
          typename MemorySpace,
          typename MemoryAccessType,
-         int VectorLength>
+         int VectorLength,
+         int Alignment>
 struct is_slice<Slice<DataType,
                       MemorySpace,
                       MemoryAccessType,
-                      VectorLength> >
+                      VectorLength,
+                      Alignment> >
     : public std::true_type {};
 
 template<typename DataType,
          typename MemorySpace,
          typename MemoryAccessType,
-         int VectorLength>
+         int VectorLength,
+         int Alignment>
 struct is_slice<const Slice<DataType,
                             MemorySpace,
                             MemoryAccessType,
-                            VectorLength> >
+                            VectorLength,
+                            Alignment> >
     : public std::true_type {};
 
+//---------------------------------------------------------------------------//
+/*!
+  \brief The rank-0 slice type of a single component of a slice.
+*/
+template<class SliceType>
+struct ComponentSlice
+{
+    using type = Slice<
+        typename Impl::ComponentDataType<
+            typename SliceType::member_slice_data_type>::type,
+        typename SliceType::memory_space,
+        typename SliceType::memory_access_type,
+        SliceType::vector_length,
+        Impl::ComponentAlignment<
+            typename std::remove_cv<
+                typename std::remove_all_extents<
+                    typename SliceType::data_type>::type>::type,
+            SliceType::vector_length,
+            SliceType::alignment>::value>;
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Get a rank-0 slice of a single component of a multidimensional
+  member slice.
+
+  The component slice views the same memory as the given slice with the
+  stride of its structs such that component-wise kernels, sort keys, and
+  binning use it directly without copying the component.
+
+  \param slice The slice to get a component of.
+  \param d0,... The component indices.
+  \return The component slice.
+*/
+template<class SliceType>
+typename std::enable_if<(is_slice<SliceType>::value && 1 == SliceType::Rank),
+                        typename ComponentSlice<SliceType>::type>::type
+subslice( const SliceType& slice, const std::size_t d0 )
+{
+    return typename ComponentSlice<SliceType>::type(
+        slice.data() + d0 * slice.stride(2),
+        slice.size(), slice.stride(0), slice.numSoA() );
+}
+
+template<class SliceType>
+typename std::enable_if<(is_slice<SliceType>::value && 2 == SliceType::Rank),
+                        typename ComponentSlice<SliceType>::type>::type
+subslice( const SliceType& slice, const std::size_t d0, const std::size_t d1 )
+{
+    return typename ComponentSlice<SliceType>::type(
+        slice.data() + d0 * slice.stride(2) + d1 * slice.stride(3),
+        slice.size(), slice.stride(0), slice.numSoA() );
+}
+
+template<class SliceType>
+typename std::enable_if<(is_slice<SliceType>::value && 3 == SliceType::Rank),
+                        typename ComponentSlice<SliceType>::type>::type
+subslice( const SliceType& slice,
+          const std::size_t d0,
+          const std::size_t d1,
+          const std::size_t d2 )
+{
+    return typename ComponentSlice<SliceType>::type(
+        slice.data() + d0 * slice.stride(2) + d1 * slice.stride(3) +
+        d2 * slice.stride(4),
+        slice.size(), slice.stride(0), slice.numSoA() );
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Cabana
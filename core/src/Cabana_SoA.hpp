@@ -85,24 +85,134 @@ struct InnerArrayType
   A statically sized array member of the struct. T can be of arbitrary type
   (including multidimensional arrays) as long as the type of T is trivial. A
   struct-of-arrays will be composed of these members of different types.
+
+  The array is aligned to the given number of bytes if it is larger than the
+  natural alignment of the array. The struct is padded such that the array of
+  the following member is aligned in the same way.
 */
-template<std::size_t I, int VectorLength, typename T>
+template<std::size_t I, int VectorLength, typename T, int Alignment>
 struct StructMember
 {
     using array_type = typename InnerArrayType<T,VectorLength>::type;
-    array_type _data;
+    static constexpr std::size_t alignment =
+        ( std::size_t(Alignment) > alignof(array_type) )
+        ? std::size_t(Alignment) : alignof(array_type);
+    alignas(alignment) array_type _data;
+};
+
+//---------------------------------------------------------------------------//
+// Compile-time member layout ordering.
+//---------------------------------------------------------------------------//
+// Given the alignment of member i, count the members which are placed before
+// it in the struct. Members are placed in order of decreasing alignment and
+// members with the same alignment keep their relative order.
+constexpr std::size_t layoutRank( const std::size_t,
+                                  const std::size_t,
+                                  const std::size_t )
+{
+    return 0;
+}
+
+template<typename... Alignments>
+constexpr std::size_t layoutRank( const std::size_t align_i,
+                                  const std::size_t i,
+                                  const std::size_t j,
+                                  const std::size_t align_j,
+                                  const Alignments... alignments )
+{
+    return ( (align_j > align_i || (align_j == align_i && j < i)) ? 1 : 0 )
+        + layoutRank( align_i, i, j+1, alignments... );
+}
+
+// Given the layout rank of each member find the member at a given position
+// in the struct.
+constexpr std::size_t layoutIndex( const std::size_t, const std::size_t i )
+{
+    return i;
+}
+
+template<typename... Ranks>
+constexpr std::size_t layoutIndex( const std::size_t position,
+                                   const std::size_t i,
+                                   const std::size_t rank_i,
+                                   const Ranks... ranks )
+{
+    return ( rank_i == position ) ? i : layoutIndex( position, i+1, ranks... );
+}
+
+// The order of the members in the struct given their layout ranks.
+template<typename RankSequence, typename PositionSequence>
+struct LayoutOrderImpl;
+
+template<std::size_t... Ranks, std::size_t... Positions>
+struct LayoutOrderImpl<IndexSequence<Ranks...>,IndexSequence<Positions...> >
+{
+    using type = IndexSequence<layoutIndex(Positions,0,Ranks...)...>;
+};
+
+// The order of the members in the struct. Members are ordered by decreasing
+// alignment. With the natural alignment (Alignment of 0) the size of every
+// member array is a multiple of its alignment so each array directly follows
+// the previous one and the only padding in the struct is at its end. With a
+// larger Alignment every array begins at a multiple of Alignment bytes so
+// there is padding after each array whose size is not a multiple of it.
+template<int VectorLength, int Alignment, typename Sequence, typename... Types>
+struct LayoutOrder;
+
+template<int VectorLength, int Alignment,
+         std::size_t... Indices, typename... Types>
+struct LayoutOrder<VectorLength,Alignment,IndexSequence<Indices...>,Types...>
+{
+    using type = typename LayoutOrderImpl<
+        IndexSequence<
+            layoutRank(
+                alignof(StructMember<Indices,VectorLength,Types,Alignment>),
+                Indices, 0,
+                alignof(StructMember<Indices,VectorLength,Types,Alignment>)...)...>,
+        IndexSequence<Indices...> >::type;
 };
 
 //---------------------------------------------------------------------------//
-// SoA implementation detail to hide the index sequence.
-template<int VectorLength, typename Sequence, typename... Types>
+// SoA implementation detail to hide the index sequence. The struct members
+// are composed in the given layout order. Each member keeps its index in the
+// member types so the layout order is not visible to users.
+template<int VectorLength, int Alignment, typename Order, typename Types>
 struct SoAImpl;
 
-template<int VectorLength, std::size_t... Indices, typename... Types>
-struct SoAImpl<VectorLength,IndexSequence<Indices...>,Types...>
-    : StructMember<Indices,VectorLength,Types>...
+template<int VectorLength, int Alignment,
+         std::size_t... Order, typename... Types>
+struct SoAImpl<VectorLength,Alignment,IndexSequence<Order...>,
+               MemberTypes<Types...> >
+    : StructMember<Order,
+                   VectorLength,
+                   typename MemberTypeAtIndex<Order,MemberTypes<Types...> >::type,
+                   Alignment>...
 {};
 
+//---------------------------------------------------------------------------//
+// Sum a list of byte counts.
+constexpr std::size_t sumBytes()
+{
+    return 0;
+}
+
+template<typename... Bytes>
+constexpr std::size_t sumBytes( const std::size_t bytes,
+                                const Bytes... more_bytes )
+{
+    return bytes + sumBytes( more_bytes... );
+}
+
+//---------------------------------------------------------------------------//
+// Check that a member array alignment is valid. An alignment of 0 uses the
+// natural alignment of each member array.
+template<int Alignment>
+struct IsAlignmentValid
+{
+    static constexpr bool value =
+        ( 0 == Alignment || (0 < Alignment && 0 == (Alignment & (Alignment-1))) );
+};
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Impl
@@ -117,20 +227,45 @@ struct SoAImpl<VectorLength,IndexSequence<Indices...>,Types...>
   members are contiguous then the struct itself will be contiguous. The layout
   of the arrays is a function of the layout type. The layout type indicates
   the size of the arrays and, if they have multidimensional data, if they are
-  row or column major order.
+  row or column major order. If an alignment in bytes is given then the array
+  of each member starts on a boundary of that alignment.
+
+  The member arrays are placed in the struct in order of decreasing alignment
+  regardless of the order of the member types so that padding is only needed
+  at the end of the struct. Members are always accessed by their index in the
+  member types.
+
+  Members declared with the Stored adapter are composed of their storage
+  type.
 */
-template<typename Types,int VectorLength>
+template<typename Types,int VectorLength,int Alignment = 0>
 struct SoA;
 
-template<typename... Types, int VectorLength>
-struct SoA<MemberTypes<Types...>,VectorLength>
+template<typename... Types, int VectorLength, int Alignment>
+struct SoA<MemberTypes<Types...>,VectorLength,Alignment>
     : Impl::SoAImpl<VectorLength,
-                    typename Impl::MakeIndexSequence<sizeof...(Types)>::type,
-                    Types...>
+                    Alignment,
+                    typename Impl::LayoutOrder<
+                        VectorLength,
+                        Alignment,
+                        typename Impl::MakeIndexSequence<sizeof...(Types)>::type,
+                        typename MemberDataType<Types>::type...>::type,
+                    MemberTypes<typename MemberDataType<Types>::type...> >
 {
+    static_assert( Impl::IsAlignmentValid<Alignment>::value,
+                   "SoA alignment must be 0 or a power of two" );
+
     // Vector length
     static constexpr int vector_length = VectorLength;
 
+    // Member array alignment in bytes.
+    static constexpr int alignment = Alignment;
+
+    // Number of bytes of member data in the struct, excluding padding.
+    static constexpr std::size_t data_bytes =
+        VectorLength *
+        Impl::sumBytes( sizeof(typename MemberDataType<Types>::type)... );
+
     // Member data types.
     using member_types = MemberTypes<Types...>;
 
@@ -140,10 +275,10 @@ struct SoA<MemberTypes<Types...>,VectorLength>
     // The maximum rank supported for member types.
     static constexpr std::size_t max_supported_rank = 3;
 
-    // Member data type.
+    // Member data type. This is the type in which the member is stored.
     template<std::size_t M>
-    using member_data_type =
-        typename MemberTypeAtIndex<M,member_types>::type;
+    using member_data_type = typename MemberDataType<
+        typename MemberTypeAtIndex<M,member_types>::type>::type;
 
     // Value type at a given index M.
     template<std::size_t M>
@@ -206,7 +341,7 @@ struct SoA<MemberTypes<Types...>,VectorLength>
                             member_reference_type<M> >::type
     get( const A& a )
     {
-        Impl::StructMember<M,vector_length,member_data_type<M> >& base = *this;
+        Impl::StructMember<M,vector_length,member_data_type<M>,alignment>& base = *this;
         return base._data[a];
     }
 
@@ -218,7 +353,7 @@ struct SoA<MemberTypes<Types...>,VectorLength>
                             member_value_type<M> >::type
     get( const A& a ) const
     {
-        const Impl::StructMember<M,vector_length,member_data_type<M> >& base = *this;
+        const Impl::StructMember<M,vector_length,member_data_type<M>,alignment>& base = *this;
         return base._data[a];
     }
 
@@ -234,7 +369,7 @@ struct SoA<MemberTypes<Types...>,VectorLength>
     get(  const A& a,
           const D0& d0 )
     {
-        Impl::StructMember<M,vector_length,member_data_type<M> >& base = *this;
+        Impl::StructMember<M,vector_length,member_data_type<M>,alignment>& base = *this;
         return base._data[d0][a];
     }
 
@@ -249,7 +384,7 @@ struct SoA<MemberTypes<Types...>,VectorLength>
     get(  const A& a,
           const D0& d0 ) const
     {
-        const Impl::StructMember<M,vector_length,member_data_type<M> >& base = *this;
+        const Impl::StructMember<M,vector_length,member_data_type<M>,alignment>& base = *this;
         return base._data[d0][a];
     }
 
@@ -268,7 +403,7 @@ struct SoA<MemberTypes<Types...>,VectorLength>
          const D0& d0,
          const D1& d1 )
     {
-        Impl::StructMember<M,vector_length,member_data_type<M> >& base = *this;
+        Impl::StructMember<M,vector_length,member_data_type<M>,alignment>& base = *this;
         return base._data[d0][d1][a];
     }
 
@@ -286,7 +421,7 @@ struct SoA<MemberTypes<Types...>,VectorLength>
          const D0& d0,
          const D1& d1 ) const
     {
-        const Impl::StructMember<M,vector_length,member_data_type<M> >& base = *this;
+        const Impl::StructMember<M,vector_length,member_data_type<M>,alignment>& base = *this;
         return base._data[d0][d1][a];
     }
 
@@ -308,7 +443,7 @@ struct SoA<MemberTypes<Types...>,VectorLength>
          const D1& d1,
          const D2& d2 )
     {
-        Impl::StructMember<M,vector_length,member_data_type<M> >& base = *this;
+        Impl::StructMember<M,vector_length,member_data_type<M>,alignment>& base = *this;
         return base._data[d0][d1][d2][a];
     }
 
@@ -329,7 +464,7 @@ struct SoA<MemberTypes<Types...>,VectorLength>
          const D1& d1,
          const D2& d2 ) const
     {
-        const Impl::StructMember<M,vector_length,member_data_type<M> >& base = *this;
+        const Impl::StructMember<M,vector_length,member_data_type<M>,alignment>& base = *this;
         return base._data[d0][d1][d2][a];
     }
 
@@ -340,7 +475,7 @@ struct SoA<MemberTypes<Types...>,VectorLength>
     template<std::size_t M>
     void* ptr()
     {
-        Impl::StructMember<M,vector_length,member_data_type<M> >& base = *this;
+        Impl::StructMember<M,vector_length,member_data_type<M>,alignment>& base = *this;
         return &base;
     }
 };
@@ -355,26 +490,34 @@ namespace Impl
 // Copy a single member from one SoA to another.
 
 // Rank 0
-template<std::size_t M, int DstVectorLength, int SrcVectorLength, typename... Types>
+template<std::size_t M,
+         int DstVectorLength, int DstAlignment,
+         int SrcVectorLength, int SrcAlignment,
+         typename... Types>
 KOKKOS_INLINE_FUNCTION
 typename std::enable_if<
-    (0==std::rank<typename MemberTypeAtIndex<M,MemberTypes<Types...> >::type>::value),void>::type
-soaElementMemberCopy( SoA<MemberTypes<Types...>,DstVectorLength>& dst,
+    (0==std::rank<typename MemberDataType<typename MemberTypeAtIndex<
+                  M,MemberTypes<Types...> >::type>::type>::value),void>::type
+soaElementMemberCopy( SoA<MemberTypes<Types...>,DstVectorLength,DstAlignment>& dst,
                       const std::size_t dst_idx,
-                      const SoA<MemberTypes<Types...>,SrcVectorLength>& src,
+                      const SoA<MemberTypes<Types...>,SrcVectorLength,SrcAlignment>& src,
                       const std::size_t src_idx )
 {
     dst.template get<M>( dst_idx ) = src.template get<M>( src_idx );
 }
 
 // Rank 1
-template<std::size_t M, int DstVectorLength, int SrcVectorLength, typename... Types>
+template<std::size_t M,
+         int DstVectorLength, int DstAlignment,
+         int SrcVectorLength, int SrcAlignment,
+         typename... Types>
 KOKKOS_INLINE_FUNCTION
 typename std::enable_if<
-    (1==std::rank<typename MemberTypeAtIndex<M,MemberTypes<Types...> >::type>::value),void>::type
-soaElementMemberCopy( SoA<MemberTypes<Types...>,DstVectorLength>& dst,
+    (1==std::rank<typename MemberDataType<typename MemberTypeAtIndex<
+                  M,MemberTypes<Types...> >::type>::type>::value),void>::type
+soaElementMemberCopy( SoA<MemberTypes<Types...>,DstVectorLength,DstAlignment>& dst,
                       const std::size_t dst_idx,
-                      const SoA<MemberTypes<Types...>,SrcVectorLength>& src,
+                      const SoA<MemberTypes<Types...>,SrcVectorLength,SrcAlignment>& src,
                       const std::size_t src_idx )
 {
     for ( std::size_t i0 = 0; i0 < dst.template extent<M,0>(); ++i0 )
@@ -382,13 +525,17 @@ soaElementMemberCopy( SoA<MemberTypes<Types...>,DstVectorLength>& dst,
 }
 
 // Rank 2
-template<std::size_t M, int DstVectorLength, int SrcVectorLength, typename... Types>
+template<std::size_t M,
+         int DstVectorLength, int DstAlignment,
+         int SrcVectorLength, int SrcAlignment,
+         typename... Types>
 KOKKOS_INLINE_FUNCTION
 typename std::enable_if<
-    (2==std::rank<typename MemberTypeAtIndex<M,MemberTypes<Types...> >::type>::value),void>::type
-soaElementMemberCopy( SoA<MemberTypes<Types...>,DstVectorLength>& dst,
+    (2==std::rank<typename MemberDataType<typename MemberTypeAtIndex<
+                  M,MemberTypes<Types...> >::type>::type>::value),void>::type
+soaElementMemberCopy( SoA<MemberTypes<Types...>,DstVectorLength,DstAlignment>& dst,
                       const std::size_t dst_idx,
-                      const SoA<MemberTypes<Types...>,SrcVectorLength>& src,
+                      const SoA<MemberTypes<Types...>,SrcVectorLength,SrcAlignment>& src,
                       const std::size_t src_idx )
 {
     for ( std::size_t i0 = 0; i0 < dst.template extent<M,0>(); ++i0 )
@@ -398,13 +545,17 @@ soaElementMemberCopy( SoA<MemberTypes<Types...>,DstVectorLength>& dst,
 }
 
 // Rank 3
-template<std::size_t M, int DstVectorLength, int SrcVectorLength, typename... Types>
+template<std::size_t M,
+         int DstVectorLength, int DstAlignment,
+         int SrcVectorLength, int SrcAlignment,
+         typename... Types>
 KOKKOS_INLINE_FUNCTION
 typename std::enable_if<
-    (3==std::rank<typename MemberTypeAtIndex<M,MemberTypes<Types...> >::type>::value),void>::type
-soaElementMemberCopy( SoA<MemberTypes<Types...>,DstVectorLength>& dst,
+    (3==std::rank<typename MemberDataType<typename MemberTypeAtIndex<
+                  M,MemberTypes<Types...> >::type>::type>::value),void>::type
+soaElementMemberCopy( SoA<MemberTypes<Types...>,DstVectorLength,DstAlignment>& dst,
                       const std::size_t dst_idx,
-                      const SoA<MemberTypes<Types...>,SrcVectorLength>& src,
+                      const SoA<MemberTypes<Types...>,SrcVectorLength,SrcAlignment>& src,
                       const std::size_t src_idx )
 {
     for ( std::size_t i0 = 0; i0 < dst.template extent<M,0>(); ++i0 )
@@ -416,11 +567,14 @@ soaElementMemberCopy( SoA<MemberTypes<Types...>,DstVectorLength>& dst,
 
 // Copy the values of all members of an SoA from a source to a destination at
 // the given indices.
-template<std::size_t M, int DstVectorLength, int SrcVectorLength, typename... Types>
+template<std::size_t M,
+         int DstVectorLength, int DstAlignment,
+         int SrcVectorLength, int SrcAlignment,
+         typename... Types>
 KOKKOS_INLINE_FUNCTION
-void soaElementCopy( SoA<MemberTypes<Types...>,DstVectorLength>& dst,
+void soaElementCopy( SoA<MemberTypes<Types...>,DstVectorLength,DstAlignment>& dst,
                      const std::size_t dst_idx,
-                     const SoA<MemberTypes<Types...>,SrcVectorLength>& src,
+                     const SoA<MemberTypes<Types...>,SrcVectorLength,SrcAlignment>& src,
                      const std::size_t src_idx,
                      std::integral_constant<std::size_t,M> )
 {
@@ -429,11 +583,13 @@ void soaElementCopy( SoA<MemberTypes<Types...>,DstVectorLength>& dst,
                     std::integral_constant<std::size_t,M-1>() );
 }
 
-template<int DstVectorLength, int SrcVectorLength, typename... Types>
+template<int DstVectorLength, int DstAlignment,
+         int SrcVectorLength, int SrcAlignment,
+         typename... Types>
 KOKKOS_INLINE_FUNCTION
-void soaElementCopy( SoA<MemberTypes<Types...>,DstVectorLength>& dst,
+void soaElementCopy( SoA<MemberTypes<Types...>,DstVectorLength,DstAlignment>& dst,
                      const std::size_t dst_idx,
-                     const SoA<MemberTypes<Types...>,SrcVectorLength>& src,
+                     const SoA<MemberTypes<Types...>,SrcVectorLength,SrcAlignment>& src,
                      const std::size_t src_idx,
                      std::integral_constant<std::size_t,0> )
 {
@@ -441,17 +597,106 @@ void soaElementCopy( SoA<MemberTypes<Types...>,DstVectorLength>& dst,
 }
 
 // Copy the data from one struct at a given index to another.
-template<int DstVectorLength, int SrcVectorLength, typename... Types>
+template<int DstVectorLength, int DstAlignment,
+         int SrcVectorLength, int SrcAlignment,
+         typename... Types>
 KOKKOS_INLINE_FUNCTION
-void tupleCopy( SoA<MemberTypes<Types...>,DstVectorLength>& dst,
+void tupleCopy( SoA<MemberTypes<Types...>,DstVectorLength,DstAlignment>& dst,
                 const std::size_t dst_idx,
-                const SoA<MemberTypes<Types...>,SrcVectorLength>& src,
+                const SoA<MemberTypes<Types...>,SrcVectorLength,SrcAlignment>& src,
                 const std::size_t src_idx )
 {
     soaElementCopy( dst, dst_idx, src, src_idx,
                     std::integral_constant<std::size_t,sizeof...(Types)-1>() );
 }
 
+//---------------------------------------------------------------------------//
+// Member range copy operators.
+//---------------------------------------------------------------------------//
+// Copy a run of consecutive tuples of a member between structs. Each
+// component of the member is stored contiguously over the vector length so
+// the run is copied as one contiguous block per component.
+template<std::size_t M,
+         int DstVectorLength, int DstAlignment,
+         int SrcVectorLength, int SrcAlignment,
+         typename... Types>
+KOKKOS_INLINE_FUNCTION
+void soaMemberRangeCopy(
+    SoA<MemberTypes<Types...>,DstVectorLength,DstAlignment>& dst,
+    const std::size_t dst_idx,
+    const SoA<MemberTypes<Types...>,SrcVectorLength,SrcAlignment>& src,
+    const std::size_t src_idx,
+    const std::size_t n )
+{
+    using data_type = typename MemberDataType<
+        typename MemberTypeAtIndex<M,MemberTypes<Types...> >::type>::type;
+    using value_type = typename std::remove_all_extents<data_type>::type;
+    constexpr std::size_t num_comp = sizeof(data_type) / sizeof(value_type);
+
+    StructMember<M,DstVectorLength,data_type,DstAlignment>& dst_member = dst;
+    const StructMember<M,SrcVectorLength,data_type,SrcAlignment>& src_member =
+        src;
+    value_type* dst_data =
+        reinterpret_cast<value_type*>( &dst_member._data ) + dst_idx;
+    const value_type* src_data =
+        reinterpret_cast<const value_type*>( &src_member._data ) + src_idx;
+    // A run never exceeds the vector length. Bounding the loop by it lets
+    // the compiler see that the copies stay within the member arrays.
+    for ( std::size_t c = 0; c < num_comp; ++c )
+        for ( std::size_t i = 0; i < n && i < DstVectorLength; ++i )
+            dst_data[ c * DstVectorLength + i ] =
+                src_data[ c * SrcVectorLength + i ];
+}
+
+// Copy a run of consecutive tuples of all members between structs.
+template<int DstVectorLength, int DstAlignment,
+         int SrcVectorLength, int SrcAlignment,
+         typename... Types>
+KOKKOS_INLINE_FUNCTION
+void soaRangeCopy( SoA<MemberTypes<Types...>,DstVectorLength,DstAlignment>& dst,
+                   const std::size_t dst_idx,
+                   const SoA<MemberTypes<Types...>,SrcVectorLength,SrcAlignment>& src,
+                   const std::size_t src_idx,
+                   const std::size_t n,
+                   std::integral_constant<std::size_t,0> )
+{
+    soaMemberRangeCopy<0>( dst, dst_idx, src, src_idx, n );
+}
+
+template<std::size_t M,
+         int DstVectorLength, int DstAlignment,
+         int SrcVectorLength, int SrcAlignment,
+         typename... Types>
+KOKKOS_INLINE_FUNCTION
+void soaRangeCopy( SoA<MemberTypes<Types...>,DstVectorLength,DstAlignment>& dst,
+                   const std::size_t dst_idx,
+                   const SoA<MemberTypes<Types...>,SrcVectorLength,SrcAlignment>& src,
+                   const std::size_t src_idx,
+                   const std::size_t n,
+                   std::integral_constant<std::size_t,M> )
+{
+    soaMemberRangeCopy<M>( dst, dst_idx, src, src_idx, n );
+    soaRangeCopy( dst, dst_idx, src, src_idx, n,
+                  std::integral_constant<std::size_t,M-1>() );
+}
+
+// Copy a run of n consecutive tuples starting at the given indices from one
+// struct to another. The run must fit in both structs.
+template<int DstVectorLength, int DstAlignment,
+         int SrcVectorLength, int SrcAlignment,
+         typename... Types>
+KOKKOS_INLINE_FUNCTION
+void tupleRangeCopy(
+    SoA<MemberTypes<Types...>,DstVectorLength,DstAlignment>& dst,
+    const std::size_t dst_idx,
+    const SoA<MemberTypes<Types...>,SrcVectorLength,SrcAlignment>& src,
+    const std::size_t src_idx,
+    const std::size_t n )
+{
+    soaRangeCopy( dst, dst_idx, src, src_idx, n,
+                  std::integral_constant<std::size_t,sizeof...(Types)-1>() );
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Impl
@@ -16,6 +16,8 @@
 #include <Cabana_Slice.hpp>
 #include <Cabana_DeepCopy.hpp>
 #include <Cabana_Macros.hpp>
+#include <Cabana_ScratchPool.hpp>
+#include <impl/Cabana_RadixSort.hpp>
 
 #include <Kokkos_Core.hpp>
 #include <Kokkos_Sort.hpp>
@@ -196,16 +198,96 @@ kokkosBinSort1d( KeyViewType keys,
     return kokkosBinSort( keys, comp, sort_within_bins, begin, end );
 }
 
+//---------------------------------------------------------------------------//
+// Sort keys over a range with a bin sort using half as many bins as keys.
+template<class KeyViewType>
+BinningData<
+    typename KokkosSpaceToCabana<typename KeyViewType::memory_space>::type>
+sortKeys( KeyViewType keys,
+          const std::size_t begin,
+          const std::size_t end,
+          std::false_type )
+{
+    int nbin = (end - begin) / 2;
+    return kokkosBinSort1d( keys, nbin, true, begin, end );
+}
+
+//---------------------------------------------------------------------------//
+// Sort integer keys over a range with a radix sort. The sorted keys are
+// binned with the same bins as the bin sort of other keys such that the
+// binning data does not depend on the key type.
+template<class KeyViewType>
+BinningData<
+    typename KokkosSpaceToCabana<typename KeyViewType::memory_space>::type>
+sortKeys( KeyViewType keys,
+          const std::size_t begin,
+          const std::size_t end,
+          std::true_type )
+{
+    using kokkos_memory_space = typename KeyViewType::memory_space;
+    using binning_data_type =
+        BinningData<typename KokkosSpaceToCabana<kokkos_memory_space>::type>;
+
+    typename KeyViewType::non_const_value_type min_key = 0;
+    typename KeyViewType::non_const_value_type max_key = 0;
+    if ( end > begin )
+    {
+        auto key_bounds = keyMinMax( keys, begin, end );
+        min_key = key_bounds.min_val;
+        max_key = key_bounds.max_val;
+    }
+    auto permute_vector =
+        radixSortPermutation( keys, begin, end, min_key, max_key );
+
+    // Count the sorted keys in each of the bins of the bin sort. The key
+    // differences are taken between the unsigned radix keys such that they
+    // do not overflow for signed keys spanning more than half of their
+    // range. Keys which are all equal are placed in the first bin.
+    using radix_key = RadixKey<typename KeyViewType::non_const_value_type>;
+    using ukey_type = typename radix_key::type;
+    int nbin = (end - begin) / 2;
+    ukey_type umin = radix_key::map( min_key );
+    ukey_type range = radix_key::map( max_key ) - umin;
+    double bin_scale = ( 0 < range ) ? double(nbin) / double(range) : 0.0;
+    Kokkos::View<int*,kokkos_memory_space> counts(
+        "counts", ( end > begin ) ? nbin + 1 : 0 );
+    auto count_op = KOKKOS_LAMBDA( const std::size_t i )
+    {
+        ukey_type diff = radix_key::map( keys(i) ) - umin;
+        int bin = int( bin_scale * double(diff) );
+        if ( bin > nbin ) bin = nbin;
+        Kokkos::atomic_increment( &counts(bin) );
+    };
+    Kokkos::parallel_for(
+        "Cabana::sortKeys::count",
+        Kokkos::RangePolicy<typename KeyViewType::execution_space>(begin,end),
+        count_op );
+    Kokkos::fence();
+
+    typename binning_data_type::OffsetView offsets(
+        "offsets", counts.extent(0) );
+    auto offset_op = KOKKOS_LAMBDA( const std::size_t b,
+                                    typename binning_data_type::size_type& offset,
+                                    const bool final_pass )
+    {
+        if ( final_pass ) offsets( b ) = offset;
+        offset += counts( b );
+    };
+    Kokkos::parallel_scan(
+        "Cabana::sortKeys::offsets",
+        Kokkos::RangePolicy<typename KeyViewType::execution_space>(
+            0,counts.extent(0)),
+        offset_op );
+    Kokkos::fence();
+
+    return binning_data_type( begin, end, counts, offsets, permute_vector );
+}
+
 //---------------------------------------------------------------------------//
 // Copy the a 1D slice into a Kokkos view.
-template<class SliceType>
-Kokkos::View<typename SliceType::value_type*,
-             typename SliceType::kokkos_memory_space>
-copySliceToKeys( SliceType slice )
+template<class SliceType, class KeyViewType>
+void copySliceToKeys( SliceType slice, KeyViewType keys )
 {
-    using KeyViewType = Kokkos::View<typename SliceType::value_type*,
-                                     typename SliceType::kokkos_memory_space>;
-    KeyViewType keys( "slice_keys", slice.size() );
     Kokkos::RangePolicy<typename SliceType::kokkos_execution_space>
         exec_policy( 0, slice.size() );
     auto copy_op = KOKKOS_LAMBDA( const std::size_t i ) { keys(i) = slice(i); };
@@ -213,7 +295,6 @@ copySliceToKeys( SliceType slice )
                           exec_policy,
                           copy_op );
     Kokkos::fence();
-    return keys;
 }
 
 //---------------------------------------------------------------------------//
@@ -360,6 +441,10 @@ binByKeyWithComparator( KeyViewType keys,
   \param end The end index of the AoSoA range to sort.
 
   \return The permutation vector associated with the sorting.
+
+  Integer keys are sorted with a stable radix sort and other keys are sorted
+  with a bin sort over the range of key values. In both cases the range of
+  key values is divided into (end - begin) / 2 bins.
 */
 template<class KeyViewType>
 BinningData<
@@ -370,10 +455,11 @@ sortByKey( KeyViewType keys,
            typename std::enable_if<
            (Kokkos::is_view<KeyViewType>::value),int>::type* = 0 )
 {
-    int nbin = (end - begin) / 2;
-    auto bin_data =
-        Impl::kokkosBinSort1d( keys, nbin, true, begin, end );
-    return bin_data;
+    return Impl::sortKeys(
+        keys, begin, end,
+        std::integral_constant<
+        bool,Impl::RadixKey<
+        typename KeyViewType::non_const_value_type>::is_valid>() );
 }
 
 //---------------------------------------------------------------------------//
@@ -478,8 +564,15 @@ sortByKey(
     const std::size_t end,
     typename std::enable_if<(is_slice<SliceType>::value),int>::type * = 0 )
 {
-    auto keys = Impl::copySliceToKeys( slice );
-    return sortByKey( keys, begin, end );
+    static_assert( 0 == SliceType::Rank,
+                   "Keys must be a rank-0 slice. Use subslice() to get a "
+                   "component of a multidimensional member" );
+    Impl::ScratchView<
+        typename std::remove_const<typename SliceType::value_type>::type,
+        typename SliceType::kokkos_memory_space>
+        keys( "slice_keys", slice.size() );
+    Impl::copySliceToKeys( slice, keys.view() );
+    return sortByKey( keys.view(), begin, end );
 }
 
 //---------------------------------------------------------------------------//
@@ -528,8 +621,15 @@ binByKey(
     const std::size_t end,
     typename std::enable_if<(is_slice<SliceType>::value),int>::type * = 0 )
 {
-    auto keys = Impl::copySliceToKeys( slice );
-    return binByKey( keys, nbin, begin, end );
+    static_assert( 0 == SliceType::Rank,
+                   "Keys must be a rank-0 slice. Use subslice() to get a "
+                   "component of a multidimensional member" );
+    Impl::ScratchView<
+        typename std::remove_const<typename SliceType::value_type>::type,
+        typename SliceType::kokkos_memory_space>
+        keys( "slice_keys", slice.size() );
+    Impl::copySliceToKeys( slice, keys.view() );
+    return binByKey( keys.view(), nbin, begin, end );
 }
 
 //---------------------------------------------------------------------------//
@@ -566,6 +666,12 @@ binByKey(
   \param binning_data The binning data.
 
   \param aosoa The AoSoA to permute.
+
+  The permutation is staged through temporary storage drawn from the scratch
+  pool of the memory space (see reserveScratch()). The temporary storage has
+  the struct layout of the AoSoA such that the permuted tuples are gathered
+  directly into it and copied back as contiguous runs of whole structs. Use
+  permute(PermuteByMember,...) to bound the size of the temporary storage.
  */
 template<class BinningDataType, class AoSoA_t>
 void permute( const BinningDataType& binning_data,
@@ -574,18 +680,30 @@ void permute( const BinningDataType& binning_data,
                                        is_aosoa<AoSoA_t>::value),
               int>::type * = 0)
 {
+    using soa_type = typename AoSoA_t::soa_type;
+    using index_type = typename AoSoA_t::index_type;
+    constexpr std::size_t vector_length = AoSoA_t::vector_length;
+
     auto begin = binning_data.rangeBegin();
     auto end = binning_data.rangeEnd();
+    if ( end <= begin ) return;
 
-    Kokkos::View<typename AoSoA_t::tuple_type*,
-                 typename BinningDataType::KokkosMemorySpace>
-        scratch_tuples( "scratch_tuples", end - begin );
+    // The scratch structs cover the structs of the range such that tuple i
+    // of the AoSoA is at the same position within a struct in the scratch.
+    std::size_t s_begin = index_type::s( begin );
+    std::size_t s_end = index_type::s( end - 1 ) + 1;
+    Impl::ScratchView<soa_type,typename BinningDataType::KokkosMemorySpace>
+        scratch( "scratch_structs", s_end - s_begin );
+    auto scratch_structs = scratch.view();
 
     auto permute_to_scratch =
         KOKKOS_LAMBDA( const std::size_t i )
         {
-            scratch_tuples( i - begin ) =
-                aosoa.getTuple( binning_data.permutation(i-begin) );
+            std::size_t p = binning_data.permutation( i - begin );
+            Impl::tupleCopy( scratch_structs( index_type::s(i) - s_begin ),
+                             index_type::a(i),
+                             aosoa.access( index_type::s(p) ),
+                             index_type::a(p) );
         };
     Kokkos::parallel_for(
         "Cabana::kokkosBinSort::permute_to_scratch",
@@ -593,15 +711,225 @@ void permute( const BinningDataType& binning_data,
         permute_to_scratch );
     Kokkos::fence();
 
-    auto copy_back = KOKKOS_LAMBDA( const std::size_t i )
-                     { aosoa.setTuple( i, scratch_tuples(i-begin) ); };
+    auto copy_back =
+        KOKKOS_LAMBDA( const std::size_t s )
+        {
+            std::size_t a_begin =
+                ( s * vector_length > begin ) ? 0 : index_type::a( begin );
+            std::size_t a_end =
+                ( (s+1) * vector_length < end )
+                ? vector_length : end - s * vector_length;
+            Impl::tupleRangeCopy( aosoa.access( s ), a_begin,
+                                  scratch_structs( s - s_begin ), a_begin,
+                                  a_end - a_begin );
+        };
     Kokkos::parallel_for(
         "Cabana::kokkosBinSort::copy_back",
-        Kokkos::RangePolicy<typename BinningDataType::KokkosExecutionSpace>(begin,end),
+        Kokkos::RangePolicy<typename BinningDataType::KokkosExecutionSpace>(s_begin,s_end),
         copy_back );
     Kokkos::fence();
 }
 
+//---------------------------------------------------------------------------//
+//! Permute tag. Permute the members of an AoSoA one at a time through
+//! scratch storage holding a single member component of the range rather
+//! than whole structs.
+struct PermuteByMember_t {};
+
+constexpr PermuteByMember_t PermuteByMember = PermuteByMember_t();
+
+namespace Impl
+{
+//---------------------------------------------------------------------------//
+// Permute the data of a slice over the binning range one member component at
+// a time. Each component of the range is gathered into scratch storage and
+// scattered back such that the scratch only holds one component of the
+// range.
+template<class BinningDataType, class SliceType>
+void permuteSliceComponents( const BinningDataType& binning_data,
+                             const SliceType& slice )
+{
+    static_assert( !SliceType::is_read_only,
+                   "Cannot permute a read-only slice" );
+
+    using data_type = typename SliceType::data_type;
+    using value_type = typename std::remove_all_extents<data_type>::type;
+    using index_type = typename SliceType::index_type;
+    constexpr std::size_t vector_length = SliceType::vector_length;
+
+    auto begin = binning_data.rangeBegin();
+    auto end = binning_data.rangeEnd();
+    if ( end <= begin ) return;
+
+    // Components of the member are contiguous arrays within a struct.
+    const std::size_t num_comp = sizeof(data_type) / sizeof(value_type);
+    auto data = slice.data();
+    std::size_t soa_stride = slice.stride( 0 );
+
+    Impl::ScratchView<value_type,typename BinningDataType::KokkosMemorySpace>
+        scratch( "scratch_component", end - begin );
+    auto values = scratch.view();
+
+    for ( std::size_t c = 0; c < num_comp; ++c )
+    {
+        std::size_t offset = c * vector_length;
+
+        auto gather =
+            KOKKOS_LAMBDA( const std::size_t i )
+            {
+                std::size_t p = binning_data.permutation( i - begin );
+                values( i - begin ) =
+                    data[ index_type::s(p) * soa_stride + offset +
+                          index_type::a(p) ];
+            };
+        Kokkos::parallel_for(
+            "Cabana::permuteSliceComponents::gather",
+            Kokkos::RangePolicy<typename BinningDataType::KokkosExecutionSpace>(begin,end),
+            gather );
+        Kokkos::fence();
+
+        auto scatter =
+            KOKKOS_LAMBDA( const std::size_t i )
+            {
+                data[ index_type::s(i) * soa_stride + offset +
+                      index_type::a(i) ] = values( i - begin );
+            };
+        Kokkos::parallel_for(
+            "Cabana::permuteSliceComponents::scatter",
+            Kokkos::RangePolicy<typename BinningDataType::KokkosExecutionSpace>(begin,end),
+            scatter );
+        Kokkos::fence();
+    }
+}
+
+//---------------------------------------------------------------------------//
+// Static loop over the AoSoA members permuting each one.
+template<class BinningDataType, class AoSoA_t>
+void permuteMembers( const BinningDataType& binning_data,
+                     const AoSoA_t& aosoa,
+                     std::integral_constant<std::size_t,0> )
+{
+    permuteSliceComponents( binning_data, aosoa.template slice<0>() );
+}
+
+template<class BinningDataType, class AoSoA_t, std::size_t M>
+void permuteMembers( const BinningDataType& binning_data,
+                     const AoSoA_t& aosoa,
+                     std::integral_constant<std::size_t,M> )
+{
+    permuteSliceComponents( binning_data, aosoa.template slice<M>() );
+    permuteMembers( binning_data, aosoa,
+                    std::integral_constant<std::size_t,M-1>() );
+}
+
+//---------------------------------------------------------------------------//
+// Permute a list of AoSoA members.
+template<class BinningDataType, class AoSoA_t>
+void permuteMemberList( const BinningDataType&, const AoSoA_t& )
+{}
+
+template<std::size_t M, std::size_t... Ms,
+         class BinningDataType, class AoSoA_t>
+void permuteMemberList( const BinningDataType& binning_data,
+                        const AoSoA_t& aosoa )
+{
+    permuteSliceComponents( binning_data, aosoa.template slice<M>() );
+    permuteMemberList<Ms...>( binning_data, aosoa );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Impl
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Given binning data permute an AoSoA one member component at a time.
+
+  \tparam BinningDataType The binning data type.
+
+  \tparm AoSoA_t The AoSoA type.
+
+  \param tag Tag indicating the members are permuted one at a time.
+
+  \param binning_data The binning data.
+
+  \param aosoa The AoSoA to permute.
+
+  The temporary storage drawn from the scratch pool of the memory space only
+  holds one member component of the range instead of whole structs, which
+  bounds the peak memory of the permutation to a small fraction of the
+  AoSoA at the cost of a pair of passes over the permutation per member
+  component.
+ */
+template<class BinningDataType, class AoSoA_t>
+void permute( PermuteByMember_t,
+              const BinningDataType& binning_data,
+              AoSoA_t& aosoa,
+              typename std::enable_if<(is_binning_data<BinningDataType>::value &&
+                                       is_aosoa<AoSoA_t>::value),
+              int>::type * = 0)
+{
+    Impl::permuteMembers(
+        binning_data, aosoa,
+        std::integral_constant<std::size_t,AoSoA_t::number_of_members-1>() );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Given binning data permute a subset of the members of an AoSoA.
+
+  \tparam M,Ms The indices of the members to permute.
+
+  \tparam BinningDataType The binning data type.
+
+  \tparm AoSoA_t The AoSoA type.
+
+  \param binning_data The binning data.
+
+  \param aosoa The AoSoA to permute.
+
+  The members are permuted one component at a time as with
+  permute(PermuteByMember,...) such that only the data of the given members
+  is moved. The other members are not modified.
+ */
+template<std::size_t M, std::size_t... Ms,
+         class BinningDataType, class AoSoA_t>
+void permute( const BinningDataType& binning_data,
+              AoSoA_t& aosoa,
+              typename std::enable_if<(is_binning_data<BinningDataType>::value &&
+                                       is_aosoa<AoSoA_t>::value),
+              int>::type * = 0)
+{
+    Impl::permuteMemberList<M,Ms...>( binning_data, aosoa );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Given binning data permute the data of a slice.
+
+  \tparam BinningDataType The binning data type.
+
+  \tparm SliceType The slice type.
+
+  \param binning_data The binning data.
+
+  \param slice The slice to permute.
+
+  The slice may be of any container with at least the range of the binning
+  data, e.g. an auxiliary AoSoA which is kept in the same order as the
+  binned one. The slice is permuted one component at a time through scratch
+  storage holding a single component of the range.
+ */
+template<class BinningDataType, class SliceType>
+void permute( const BinningDataType& binning_data,
+              const SliceType& slice,
+              typename std::enable_if<(is_binning_data<BinningDataType>::value &&
+                                       is_slice<SliceType>::value),
+              int>::type * = 0)
+{
+    Impl::permuteSliceComponents( binning_data, slice );
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Cabana
@@ -0,0 +1,257 @@
+/****************************************************************************
+ * Copyright (c) 2018 by the Cabana authors                                 *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef CABANA_SPACEFILLINGCURVE_HPP
+#define CABANA_SPACEFILLINGCURVE_HPP
+
+#include <Cabana_Macros.hpp>
+#include <Cabana_ScratchPool.hpp>
+#include <Cabana_Slice.hpp>
+#include <Cabana_Sort.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <cstdint>
+#include <type_traits>
+
+namespace Cabana
+{
+//---------------------------------------------------------------------------//
+/*!
+  \brief Space-filling curves used to order particles.
+
+  Morton (Z-order) keys interleave the bits of the cell coordinates. Hilbert
+  keys additionally rotate and reflect the sub-cubes at every level such that
+  consecutive cells along the curve are always face neighbors, which gives
+  better locality at a slightly higher cost per key.
+*/
+enum class SpaceFillingCurve
+{
+    Morton,
+    Hilbert
+};
+
+namespace Impl
+{
+//---------------------------------------------------------------------------//
+// Number of bits of each cell coordinate in a 63-bit curve key.
+constexpr int curve_bits = 21;
+
+//---------------------------------------------------------------------------//
+// Spread the lower 21 bits of a value such that there are two zero bits
+// between each of them.
+CABANA_INLINE_FUNCTION
+std::uint64_t spreadBits( std::uint64_t x )
+{
+    x &= 0x1fffff;
+    x = ( x | x << 32 ) & 0x1f00000000ffff;
+    x = ( x | x << 16 ) & 0x1f0000ff0000ff;
+    x = ( x | x << 8 ) & 0x100f00f00f00f00f;
+    x = ( x | x << 4 ) & 0x10c30c30c30c30c3;
+    x = ( x | x << 2 ) & 0x1249249249249249;
+    return x;
+}
+
+//---------------------------------------------------------------------------//
+// Morton key of 21-bit cell coordinates. The first coordinate is the most
+// significant.
+CABANA_INLINE_FUNCTION
+std::uint64_t mortonKey( const std::uint32_t i,
+                         const std::uint32_t j,
+                         const std::uint32_t k )
+{
+    return ( spreadBits(i) << 2 ) | ( spreadBits(j) << 1 ) | spreadBits(k);
+}
+
+//---------------------------------------------------------------------------//
+// Hilbert key of 21-bit cell coordinates. The coordinates are transformed
+// into the transposed Hilbert index (J. Skilling, "Programming the Hilbert
+// curve", AIP Conf. Proc. 707, 2004) whose bits are then interleaved.
+CABANA_INLINE_FUNCTION
+std::uint64_t hilbertKey( const std::uint32_t i,
+                          const std::uint32_t j,
+                          const std::uint32_t k )
+{
+    std::uint32_t x[3] = { i, j, k };
+    const std::uint32_t m = 1u << ( curve_bits - 1 );
+
+    // Inverse undo.
+    for ( std::uint32_t q = m; q > 1; q >>= 1 )
+    {
+        std::uint32_t p = q - 1;
+        for ( int d = 0; d < 3; ++d )
+        {
+            if ( x[d] & q )
+            {
+                x[0] ^= p;
+            }
+            else
+            {
+                std::uint32_t t = ( x[0] ^ x[d] ) & p;
+                x[0] ^= t;
+                x[d] ^= t;
+            }
+        }
+    }
+
+    // Gray encode.
+    x[1] ^= x[0];
+    x[2] ^= x[1];
+    std::uint32_t t = 0;
+    for ( std::uint32_t q = m; q > 1; q >>= 1 )
+        if ( x[2] & q ) t ^= q - 1;
+    for ( int d = 0; d < 3; ++d )
+        x[d] ^= t;
+
+    return mortonKey( x[0], x[1], x[2] );
+}
+
+//---------------------------------------------------------------------------//
+// Map positions in a bounding box onto the 21-bit cell coordinates of the
+// curve. Positions outside of the box are clamped to it.
+template<class Real>
+class CurveGrid
+{
+  public:
+
+    CurveGrid( const Real grid_min[3], const Real grid_max[3] )
+    {
+        for ( int d = 0; d < 3; ++d )
+        {
+            _min[d] = grid_min[d];
+            Real extent = grid_max[d] - grid_min[d];
+            _scale[d] = ( extent > 0 ) ? Real(1u << curve_bits) / extent : 0;
+        }
+    }
+
+    CABANA_INLINE_FUNCTION
+    std::uint32_t coordinate( const Real x, const int d ) const
+    {
+        Real c = ( x - _min[d] ) * _scale[d];
+        if ( !(c > 0) ) return 0;
+        const std::uint32_t max_c = ( 1u << curve_bits ) - 1;
+        return ( c < Real(max_c) ) ? std::uint32_t( c ) : max_c;
+    }
+
+  private:
+
+    Real _min[3];
+    Real _scale[3];
+};
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Impl
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Sort an AoSoA over a subset of its range along a space-filling curve
+  through its positions.
+
+  \tparam SliceType Slice type for positions.
+
+  \param positions Slice of positions.
+
+  \param begin The beginning index of the AoSoA range to sort.
+
+  \param end The end index of the AoSoA range to sort.
+
+  \param grid_min Bounding box minimum value in each direction.
+
+  \param grid_max Bounding box maximum value in each direction.
+
+  \param curve The space-filling curve.
+
+  \return The binning data of the sort. Use permute() to reorder the AoSoA.
+
+  The bounding box is divided into 2^21 cells in each direction and a 63-bit
+  curve key is computed for the cell of every position in parallel. Positions
+  outside of the box are clamped to it. The keys are sorted with the integer
+  key sort of sortByKey() such that positions in the same cell keep their
+  order.
+*/
+template<class SliceType>
+BinningData<typename SliceType::memory_space>
+sortBySpaceFillingCurve(
+    SliceType positions,
+    const std::size_t begin,
+    const std::size_t end,
+    const typename SliceType::value_type grid_min[3],
+    const typename SliceType::value_type grid_max[3],
+    const SpaceFillingCurve curve = SpaceFillingCurve::Morton,
+    typename std::enable_if<(is_slice<SliceType>::value),int>::type * = 0 )
+{
+    static_assert( 1 == SliceType::Rank,
+                   "Positions must be a slice of a rank-1 member" );
+
+    using real_type =
+        typename std::remove_const<typename SliceType::value_type>::type;
+    using kokkos_memory_space = typename SliceType::kokkos_memory_space;
+    using kokkos_execution_space = typename SliceType::kokkos_execution_space;
+
+    Impl::CurveGrid<real_type> grid( grid_min, grid_max );
+    Impl::ScratchView<std::uint64_t,kokkos_memory_space>
+        keys( "curve_keys", positions.size() );
+    auto key_view = keys.view();
+    bool hilbert = ( SpaceFillingCurve::Hilbert == curve );
+
+    auto key_op = KOKKOS_LAMBDA( const std::size_t p )
+    {
+        std::uint32_t i = grid.coordinate( positions(p,0), 0 );
+        std::uint32_t j = grid.coordinate( positions(p,1), 1 );
+        std::uint32_t k = grid.coordinate( positions(p,2), 2 );
+        key_view( p ) = hilbert ? Impl::hilbertKey( i, j, k )
+                                : Impl::mortonKey( i, j, k );
+    };
+    Kokkos::parallel_for(
+        "Cabana::sortBySpaceFillingCurve::key_op",
+        Kokkos::RangePolicy<kokkos_execution_space>(begin,end),
+        key_op );
+    Kokkos::fence();
+
+    return sortByKey( key_view, begin, end );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Sort an entire AoSoA along a space-filling curve through its
+  positions.
+
+  \tparam SliceType Slice type for positions.
+
+  \param positions Slice of positions.
+
+  \param grid_min Bounding box minimum value in each direction.
+
+  \param grid_max Bounding box maximum value in each direction.
+
+  \param curve The space-filling curve.
+
+  \return The binning data of the sort. Use permute() to reorder the AoSoA.
+*/
+template<class SliceType>
+BinningData<typename SliceType::memory_space>
+sortBySpaceFillingCurve(
+    SliceType positions,
+    const typename SliceType::value_type grid_min[3],
+    const typename SliceType::value_type grid_max[3],
+    const SpaceFillingCurve curve = SpaceFillingCurve::Morton,
+    typename std::enable_if<(is_slice<SliceType>::value),int>::type * = 0 )
+{
+    return sortBySpaceFillingCurve(
+        positions, 0, positions.size(), grid_min, grid_max, curve );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Cabana
+
+#endif // end CABANA_SPACEFILLINGCURVE_HPP
@@ -0,0 +1,317 @@
+/****************************************************************************
+ * Copyright (c) 2018 by the Cabana authors                                 *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef CABANA_SUBVIEW_HPP
+#define CABANA_SUBVIEW_HPP
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_Macros.hpp>
+
+#include <type_traits>
+#include <utility>
+#include <stdexcept>
+
+namespace Cabana
+{
+//---------------------------------------------------------------------------//
+/*!
+  \class SubviewSlice
+
+  \brief A slice of a tuple member over the range of an AoSoA subview.
+
+  Tuple indices are local to the range and are offset by the beginning of
+  the range when the underlying slice is accessed such that the range may
+  begin anywhere in a struct.
+
+  \tparam SliceType The type of the slice of the member over the AoSoA.
+*/
+template<class SliceType>
+class SubviewSlice
+{
+  public:
+
+    // Slice type.
+    using slice_type = SliceType;
+
+    // Memory space.
+    using memory_space = typename slice_type::memory_space;
+
+    // Vector length.
+    static constexpr int vector_length = slice_type::vector_length;
+
+    // Index type.
+    using index_type = typename slice_type::index_type;
+
+    // Reference type.
+    using reference_type = typename slice_type::reference_type;
+
+    /*!
+      \brief Constructor.
+
+      \param slice The slice of the member over the AoSoA.
+
+      \param begin The index of the first tuple in the range.
+
+      \param end The index after the last tuple in the range.
+    */
+    SubviewSlice( const slice_type& slice,
+                  const std::size_t begin,
+                  const std::size_t end )
+        : _slice( slice )
+        , _begin( begin )
+        , _end( end )
+    {}
+
+    /*!
+      \brief Returns the number of tuples in the range.
+    */
+    CABANA_INLINE_FUNCTION
+    std::size_t size() const { return _end - _begin; }
+
+    /*!
+      \brief Returns the number of structs the range spans.
+    */
+    CABANA_INLINE_FUNCTION
+    std::size_t numSoA() const
+    {
+        return ( _end > _begin )
+            ? index_type::s( _end - 1 ) - index_type::s( _begin ) + 1 : 0;
+    }
+
+    /*!
+      \brief The index of the first tuple of the range in the AoSoA.
+    */
+    CABANA_INLINE_FUNCTION
+    std::size_t rangeBegin() const { return _begin; }
+
+    /*!
+      \brief The index after the last tuple of the range in the AoSoA.
+    */
+    CABANA_INLINE_FUNCTION
+    std::size_t rangeEnd() const { return _end; }
+
+    /*!
+      \brief Get the slice of the member over the AoSoA.
+    */
+    CABANA_INLINE_FUNCTION
+    const slice_type& slice() const { return _slice; }
+
+    /*!
+      \brief Access a tuple member at a local index.
+
+      \param i The local tuple index.
+
+      \param d The indices of the member component, one per member rank.
+    */
+    template<typename I, typename... Indices>
+    CABANA_FORCEINLINE_FUNCTION
+    typename std::enable_if<std::is_integral<I>::value,reference_type>::type
+    operator()( const I& i, const Indices&... d ) const
+    { return _slice( _begin + i, d... ); }
+
+  private:
+
+    // The slice over the AoSoA. This is a shallow copy.
+    slice_type _slice;
+
+    // Beginning of the range.
+    std::size_t _begin;
+
+    // End of the range.
+    std::size_t _end;
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \class AoSoASubview
+
+  \brief A non-owning view of a contiguous range of tuples in an AoSoA.
+
+  A subview gives access to the tuples [begin,end) of an AoSoA without
+  copying them. Tuple indices in the subview are local to the range such that
+  index 0 refers to tuple begin of the AoSoA. Like slices, a subview is
+  invalidated when the underlying AoSoA is reallocated.
+
+  \tparam AoSoA_t The type of AoSoA being viewed.
+*/
+template<class AoSoA_t>
+class AoSoASubview
+{
+  public:
+
+    // AoSoA type.
+    using aosoa_type = AoSoA_t;
+
+    // Member data types.
+    using member_types = typename aosoa_type::member_types;
+
+    // Memory space.
+    using memory_space = typename aosoa_type::memory_space;
+
+    // Vector length.
+    static constexpr int vector_length = aosoa_type::vector_length;
+
+    // SoA type.
+    using soa_type = typename aosoa_type::soa_type;
+
+    // Index type.
+    using index_type = typename aosoa_type::index_type;
+
+    // Tuple type.
+    using tuple_type = typename aosoa_type::tuple_type;
+
+    // Slice type of a given member.
+    template<std::size_t M>
+    using member_slice_type = SubviewSlice<
+        decltype( std::declval<aosoa_type>().template slice<M>() )>;
+
+  public:
+
+    /*!
+      \brief Constructor.
+
+      \param aosoa The AoSoA to view.
+
+      \param begin The index of the first tuple in the view.
+
+      \param end The index after the last tuple in the view.
+    */
+    AoSoASubview( const aosoa_type& aosoa,
+                  const std::size_t begin,
+                  const std::size_t end )
+        : _aosoa( aosoa )
+        , _begin( begin )
+        , _end( end )
+    {
+        if ( end < begin || aosoa.size() < end )
+            throw std::runtime_error( "Invalid AoSoA subview range" );
+    }
+
+    /*!
+      \brief Returns the number of tuples in the subview.
+    */
+    CABANA_INLINE_FUNCTION
+    std::size_t size() const { return _end - _begin; }
+
+    /*!
+      \brief The index of the first tuple of the subview in the AoSoA.
+    */
+    CABANA_INLINE_FUNCTION
+    std::size_t rangeBegin() const { return _begin; }
+
+    /*!
+      \brief The index after the last tuple of the subview in the AoSoA.
+    */
+    CABANA_INLINE_FUNCTION
+    std::size_t rangeEnd() const { return _end; }
+
+    /*!
+      \brief Get the AoSoA being viewed.
+    */
+    const aosoa_type& aosoa() const { return _aosoa; }
+
+    /*!
+      \brief Get a tuple at a given local index via a deep copy.
+
+      \param i The local index to get the tuple from.
+
+      \return A tuple containing a deep copy of the data at the given index.
+    */
+    template<typename I>
+    CABANA_INLINE_FUNCTION
+    typename std::enable_if<std::is_integral<I>::value,tuple_type>::type
+    getTuple( const I& i ) const
+    {
+        return _aosoa.getTuple( _begin + i );
+    }
+
+    /*!
+      \brief Set a tuple at a given local index via a deep copy.
+
+      \param i The local index to set the tuple at.
+
+      \param tuple The tuple to get the data from.
+    */
+    template<typename I>
+    CABANA_INLINE_FUNCTION
+    typename std::enable_if<std::is_integral<I>::value,void>::type
+    setTuple( const I& i,
+              const tuple_type& tpl ) const
+    {
+        _aosoa.setTuple( _begin + i, tpl );
+    }
+
+    /*!
+      \brief Get a slice of a tuple member over the subview range.
+
+      \tparam M The member index to get a slice of.
+
+      \return The member slice. Index 0 of the slice refers to the first tuple
+      of the subview which may be anywhere in a struct.
+    */
+    template<std::size_t M>
+    member_slice_type<M> slice() const
+    {
+        return member_slice_type<M>(
+            _aosoa.template slice<M>(), _begin, _end );
+    }
+
+  private:
+
+    // The AoSoA being viewed. This is a shallow copy.
+    aosoa_type _aosoa;
+
+    // Beginning of the range.
+    std::size_t _begin;
+
+    // End of the range.
+    std::size_t _end;
+};
+
+//---------------------------------------------------------------------------//
+// Static type checker.
+template<class >
+struct is_aosoa_subview : public std::false_type {};
+
+template<class AoSoA_t>
+struct is_aosoa_subview<AoSoASubview<AoSoA_t> > : public std::true_type {};
+
+template<class AoSoA_t>
+struct is_aosoa_subview<const AoSoASubview<AoSoA_t> >
+    : public std::true_type {};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Create a non-owning view of a range of tuples in an AoSoA.
+
+  \param aosoa The AoSoA to view.
+
+  \param begin The index of the first tuple in the view.
+
+  \param end The index after the last tuple in the view.
+
+  \return The subview.
+*/
+template<class AoSoA_t>
+AoSoASubview<AoSoA_t> subview(
+    const AoSoA_t& aosoa,
+    const std::size_t begin,
+    const std::size_t end,
+    typename std::enable_if<is_aosoa<AoSoA_t>::value,int>::type * = 0 )
+{
+    return AoSoASubview<AoSoA_t>( aosoa, begin, end );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Cabana
+
+#endif // end CABANA_SUBVIEW_HPP
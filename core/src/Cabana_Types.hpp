@@ -36,6 +36,22 @@ struct HostSpace
 template<>
 struct is_memory_space<HostSpace> : public std::true_type {};
 
+//! Host memory space backed by a memory-mapped file. The AoSoA of a
+//! MappedAoSoA is in this space and stores its structs in the mapped file in
+//! their native layout such that the data is paged in by the operating system
+//! as it is accessed. Other containers in this space are allocated in host
+//! memory.
+struct MappedHostSpace
+{
+    using memory_space_type = MappedHostSpace;
+    using kokkos_memory_space = Kokkos::HostSpace;
+    using kokkos_execution_space =
+        typename kokkos_memory_space::execution_space;
+};
+
+template<>
+struct is_memory_space<MappedHostSpace> : public std::true_type {};
+
 #if defined( KOKKOS_ENABLE_CUDA )
 //! Cuda UVM memory space
 struct CudaUVMSpace
@@ -51,7 +67,9 @@ struct is_memory_space<CudaUVMSpace> : public std::true_type {};
 #endif
 
 //---------------------------------------------------------------------------//
-// Memory access tags.
+// Memory access tags. The aligned memory traits are used by slices whose
+// member arrays are aligned to the Kokkos memory alignment. The const memory
+// traits are used by read-only slices.
 //---------------------------------------------------------------------------//
 template<class >
 struct is_memory_access_tag : public std::false_type {};
@@ -62,8 +80,17 @@ struct DefaultAccessMemory
 {
     using memory_access_type = DefaultAccessMemory;
     using kokkos_memory_traits = Kokkos::MemoryTraits< Kokkos::Unmanaged |
-                                                       Kokkos::Aligned |
                                                        Kokkos::Restrict >;
+    using kokkos_aligned_memory_traits =
+        Kokkos::MemoryTraits< Kokkos::Unmanaged |
+                              Kokkos::Aligned |
+                              Kokkos::Restrict >;
+
+    // Read-only data may be aliased by other slices so it is not restricted.
+    using kokkos_const_memory_traits =
+        Kokkos::MemoryTraits< Kokkos::Unmanaged >;
+    using kokkos_const_aligned_memory_traits =
+        Kokkos::MemoryTraits< Kokkos::Unmanaged | Kokkos::Aligned >;
 };
 
 template<>
@@ -74,8 +101,13 @@ struct RandomAccessMemory
 {
     using memory_access_type = RandomAccessMemory;
     using kokkos_memory_traits = Kokkos::MemoryTraits< Kokkos::Unmanaged |
-                                                       Kokkos::Aligned |
                                                        Kokkos::RandomAccess >;
+    using kokkos_aligned_memory_traits =
+        Kokkos::MemoryTraits< Kokkos::Unmanaged |
+                              Kokkos::Aligned |
+                              Kokkos::RandomAccess >;
+    using kokkos_const_memory_traits = kokkos_memory_traits;
+    using kokkos_const_aligned_memory_traits = kokkos_aligned_memory_traits;
 };
 
 template<>
@@ -86,13 +118,31 @@ struct AtomicAccessMemory
 {
     using memory_access_type = AtomicAccessMemory;
     using kokkos_memory_traits = Kokkos::MemoryTraits< Kokkos::Unmanaged |
-                                                       Kokkos::Aligned |
                                                        Kokkos::Atomic >;
+    using kokkos_aligned_memory_traits =
+        Kokkos::MemoryTraits< Kokkos::Unmanaged |
+                              Kokkos::Aligned |
+                              Kokkos::Atomic >;
+
+    // Reads of read-only data do not need to be atomic.
+    using kokkos_const_memory_traits =
+        Kokkos::MemoryTraits< Kokkos::Unmanaged >;
+    using kokkos_const_aligned_memory_traits =
+        Kokkos::MemoryTraits< Kokkos::Unmanaged | Kokkos::Aligned >;
 };
 
 template<>
 struct is_memory_access_tag<AtomicAccessMemory> : public std::true_type {};
 
+//---------------------------------------------------------------------------//
+// Allocation tags.
+//---------------------------------------------------------------------------//
+//! Allocate memory without initializing it. Used when the contents of newly
+//! allocated memory will be overwritten before they are read.
+struct WithoutInitializing_t {};
+
+constexpr WithoutInitializing_t WithoutInitializing = WithoutInitializing_t();
+
 //---------------------------------------------------------------------------//
 // Kokkos-to-Cabana space translator
 //---------------------------------------------------------------------------//
@@ -158,7 +158,8 @@ struct VerletListBuilder
     // Cell stencil.
     LinkedCellStencil<PositionValueType> cell_stencil;
 
-    // Constructor.
+    // Constructor. The given neighbor data and linked cell list of a
+    // previous build are reused if they are large enough.
     VerletListBuilder(
         PositionSlice slice,
         const std::size_t begin,
@@ -166,11 +167,26 @@ struct VerletListBuilder
         const PositionValueType neighborhood_radius,
         const PositionValueType cell_size_ratio,
         const PositionValueType grid_min[3],
-        const PositionValueType grid_max[3])
-        : counts( "num_neighbors", slice.size() )
-        , offsets( "neighbor_offsets", slice.size() )
+        const PositionValueType grid_max[3],
+        Kokkos::View<int*,kokkos_memory_space> prev_counts,
+        Kokkos::View<int*,kokkos_memory_space> prev_offsets,
+        Kokkos::View<int*,kokkos_memory_space> prev_neighbors,
+        LinkedCellList<memory_space> prev_linked_cell_list )
+        : counts( prev_counts )
+        , offsets( prev_offsets )
+        , neighbors( prev_neighbors )
+        , linked_cell_list( prev_linked_cell_list )
         , cell_stencil( neighborhood_radius, cell_size_ratio, grid_min, grid_max )
     {
+        // Allocate the counts and offsets if the number of particles changed.
+        if ( counts.extent(0) != slice.size() )
+        {
+            counts = Kokkos::View<int*,kokkos_memory_space>(
+                "num_neighbors", slice.size() );
+            offsets = Kokkos::View<int*,kokkos_memory_space>(
+                "neighbor_offsets", slice.size() );
+        }
+
         // Get the positions with random access read-only memory.
         position = slice;
 
@@ -180,8 +196,8 @@ struct VerletListBuilder
         // treated as candidates for neighbors.
         double grid_size = cell_size_ratio * neighborhood_radius;
         PositionValueType grid_delta[3] = { grid_size, grid_size, grid_size };
-        linked_cell_list = LinkedCellList<memory_space>(
-            position, grid_delta, grid_min, grid_max );
+        linked_cell_list.build(
+            position, 0, position.size(), grid_delta, grid_min, grid_max );
         bin_data_1d = linked_cell_list.binningData();
 
         // We will use the square of the distance for neighbor determination.
@@ -308,9 +324,11 @@ struct VerletListBuilder
             range_policy, offset_op, total_num_neighbor );
         Kokkos::fence();
 
-        // Allocate the neighbor list.
-        neighbors = Kokkos::View<int*,kokkos_memory_space>(
-            "neighbors", total_num_neighbor );
+        // Allocate the neighbor list if the existing one is not large
+        // enough.
+        if ( neighbors.extent(0) < std::size_t(total_num_neighbor) )
+            neighbors = Kokkos::View<int*,kokkos_memory_space>(
+                "neighbors", total_num_neighbor );
 
         // Reset the counts. We count again when we fill.
         Kokkos::deep_copy( counts, 0 );
@@ -437,6 +455,15 @@ class VerletList
     // Neighbor list.
     Kokkos::View<int*,kokkos_memory_space> _neighbors;
 
+    // Linked cell list used to build the neighbor list.
+    LinkedCellList<memory_space> _linked_cell_list;
+
+    /*!
+      \brief Default constructor.
+    */
+    VerletList()
+    {}
+
     /*!
       \brief Given a list of particle positions and a neighborhood radius calculate
       the neighbor list.
@@ -477,13 +504,55 @@ class VerletList
         const typename PositionSlice::value_type grid_min[3],
         const typename PositionSlice::value_type grid_max[3],
         typename std::enable_if<(is_slice<PositionSlice>::value),int>::type * = 0 )
+    {
+        build( x, begin, end, neighborhood_radius, cell_size_ratio,
+               grid_min, grid_max );
+    }
+
+    /*!
+      \brief Given a list of particle positions and a neighborhood radius
+      rebuild the neighbor list.
+
+      \param x The slice containing the particle positions
+
+      \param begin The beginning particle index to compute neighbors for.
+
+      \param end The end particle index to compute neighbors for.
+
+      \param neighborhood_radius The radius of the neighborhood.
+
+      \param cell_size_ratio The ratio of the cell size in the Cartesian grid
+      to the neighborhood radius.
+
+      \param grid_min The minimum value of the grid containing the particles
+      in each dimension.
+
+      \param grid_max The maximum value of the grid containing the particles
+      in each dimension.
+
+      The memory of the previous build is reused when it is large enough so
+      rebuilding the list every step with the same number of particles and
+      grid only allocates memory when the number of neighbors grows.
+    */
+    template<class PositionSlice>
+    void build(
+        PositionSlice x,
+        const std::size_t begin,
+        const std::size_t end,
+        const typename PositionSlice::value_type neighborhood_radius,
+        const typename PositionSlice::value_type cell_size_ratio,
+        const typename PositionSlice::value_type grid_min[3],
+        const typename PositionSlice::value_type grid_max[3],
+        typename std::enable_if<(is_slice<PositionSlice>::value),int>::type * = 0 )
     {
         // Create a builder functor.
         using builder_type =
             Impl::VerletListBuilder<PositionSlice,AlgorithmTag>;
         builder_type builder( x, begin, end,
                               neighborhood_radius, cell_size_ratio,
-                              grid_min, grid_max );
+                              grid_min, grid_max,
+                              _counts, _offsets, _neighbors,
+                              _linked_cell_list );
 
         // For each particle in the range check each neighboring bin for
         // neighbor particles. Bins are at least the size of the neighborhood
@@ -512,6 +581,7 @@ class VerletList
         _counts = builder.counts;
         _offsets = builder.offsets;
         _neighbors = builder.neighbors;
+        _linked_cell_list = builder.linked_cell_list;
     }
 };
 
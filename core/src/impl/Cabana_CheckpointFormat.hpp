@@ -0,0 +1,200 @@
+/****************************************************************************
+ * Copyright (c) 2018 by the Cabana authors                                 *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef CABANA_CHECKPOINTFORMAT_HPP
+#define CABANA_CHECKPOINTFORMAT_HPP
+
+#include <impl/Cabana_IndexSequence.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace Cabana
+{
+namespace Impl
+{
+//---------------------------------------------------------------------------//
+// Checkpoint file layout. The file begins with a header followed by a
+// description of each member. The structs of the AoSoA follow in their
+// native layout at the data offset, which is padded to a multiple of the
+// struct size such that the structs are aligned when the file is mapped. All
+// values are in the byte order of the writer.
+//---------------------------------------------------------------------------//
+struct CheckpointHeader
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint32_t vector_length;
+    std::uint32_t number_of_members;
+    std::uint64_t size;
+    std::uint64_t num_soa;
+    std::uint64_t soa_bytes;
+    std::uint64_t data_offset;
+};
+
+struct CheckpointMember
+{
+    std::uint32_t kind;
+    std::uint32_t value_bytes;
+    std::uint32_t rank;
+    std::uint32_t extents[3];
+    std::uint64_t offset;
+};
+
+// Checkpoint format identifiers.
+inline const char* checkpointMagic()
+{ return "CABANACK"; }
+
+constexpr std::uint32_t checkpoint_version = 1;
+constexpr std::uint32_t checkpoint_byte_order = 0x01020304;
+
+//---------------------------------------------------------------------------//
+// Kind of a member value type: 0 for signed integers, 1 for unsigned
+// integers, 2 for floating point, and 3 for anything else.
+template<class T>
+std::uint32_t checkpointValueKind()
+{
+    return std::is_floating_point<T>::value ? 2 :
+        ( std::is_integral<T>::value ? (std::is_signed<T>::value ? 0 : 1) : 3 );
+}
+
+//---------------------------------------------------------------------------//
+// Describe a member of an AoSoA including the byte offset of its array in
+// the structs.
+template<class AoSoA_t, std::size_t M>
+CheckpointMember checkpointMember( typename AoSoA_t::soa_type& soa )
+{
+    using data_type = typename AoSoA_t::template member_data_type<M>;
+    using value_type = typename AoSoA_t::template member_value_type<M>;
+
+    CheckpointMember member;
+    member.kind = checkpointValueKind<value_type>();
+    member.value_bytes = sizeof(value_type);
+    member.rank = std::rank<data_type>::value;
+    member.extents[0] = std::extent<data_type,0>::value;
+    member.extents[1] = std::extent<data_type,1>::value;
+    member.extents[2] = std::extent<data_type,2>::value;
+    member.offset = reinterpret_cast<char*>( soa.template ptr<M>() ) -
+                    reinterpret_cast<char*>( &soa );
+    return member;
+}
+
+template<class AoSoA_t, std::size_t... Members>
+std::vector<CheckpointMember> checkpointMembers( IndexSequence<Members...> )
+{
+    typename AoSoA_t::soa_type soa;
+    return std::vector<CheckpointMember>{
+        checkpointMember<AoSoA_t,Members>( soa )... };
+}
+
+template<class AoSoA_t>
+std::vector<CheckpointMember> checkpointMembers()
+{
+    return checkpointMembers<AoSoA_t>(
+        typename MakeIndexSequence<AoSoA_t::number_of_members>::type() );
+}
+
+// Number of values in each tuple of a member.
+inline std::size_t checkpointMemberComponents( const CheckpointMember& member )
+{
+    std::size_t num_comp = 1;
+    for ( std::uint32_t d = 0; d < member.rank; ++d )
+        num_comp *= member.extents[d];
+    return num_comp;
+}
+
+//---------------------------------------------------------------------------//
+// Byte offset of the structs of an AoSoA in a checkpoint file.
+template<class AoSoA_t>
+std::size_t checkpointDataOffset()
+{
+    std::size_t soa_bytes = sizeof(typename AoSoA_t::soa_type);
+    std::size_t bytes = sizeof(CheckpointHeader) +
+                        AoSoA_t::number_of_members * sizeof(CheckpointMember);
+    return ( (bytes + soa_bytes - 1) / soa_bytes ) * soa_bytes;
+}
+
+// Create the header of a checkpoint of an AoSoA with the given number of
+// tuples and structs.
+template<class AoSoA_t>
+CheckpointHeader checkpointHeader( const std::size_t size,
+                                   const std::size_t num_soa )
+{
+    CheckpointHeader header;
+    std::memcpy( header.magic, checkpointMagic(), sizeof(header.magic) );
+    header.version = checkpoint_version;
+    header.byte_order = checkpoint_byte_order;
+    header.vector_length = AoSoA_t::vector_length;
+    header.number_of_members = AoSoA_t::number_of_members;
+    header.size = size;
+    header.num_soa = num_soa;
+    header.soa_bytes = sizeof(typename AoSoA_t::soa_type);
+    header.data_offset = checkpointDataOffset<AoSoA_t>();
+    return header;
+}
+
+//---------------------------------------------------------------------------//
+// Check that a header describes a checkpoint which may be read into an
+// AoSoA.
+template<class AoSoA_t>
+void checkCheckpointHeader( const CheckpointHeader& header )
+{
+    if ( 0 != std::memcmp(header.magic,checkpointMagic(),
+                          sizeof(header.magic)) )
+        throw std::runtime_error( "File is not a Cabana checkpoint" );
+    if ( checkpoint_version != header.version )
+        throw std::runtime_error( "Unsupported Cabana checkpoint version" );
+    if ( checkpoint_byte_order != header.byte_order )
+        throw std::runtime_error( "Cabana checkpoint byte order mismatch" );
+    if ( AoSoA_t::number_of_members != header.number_of_members )
+        throw std::runtime_error( "Cabana checkpoint member count mismatch" );
+    if ( 0 == header.vector_length || 0 == header.soa_bytes ||
+         header.num_soa * header.vector_length < header.size ||
+         header.data_offset < sizeof(CheckpointHeader) +
+         header.number_of_members * sizeof(CheckpointMember) )
+        throw std::runtime_error( "Corrupt Cabana checkpoint header" );
+}
+
+// Check the member descriptions of a checkpoint against the members of an
+// AoSoA. Returns whether the structs of the checkpoint have the layout of
+// the structs of the AoSoA.
+template<class AoSoA_t>
+bool checkCheckpointMembers( const CheckpointHeader& header,
+                             const std::vector<CheckpointMember>& src_members )
+{
+    std::vector<CheckpointMember> dst_members = checkpointMembers<AoSoA_t>();
+    bool same_layout =
+        ( AoSoA_t::vector_length == header.vector_length &&
+          sizeof(typename AoSoA_t::soa_type) == header.soa_bytes );
+    for ( std::size_t m = 0; m < dst_members.size(); ++m )
+    {
+        const CheckpointMember& src = src_members[m];
+        const CheckpointMember& dst = dst_members[m];
+        if ( src.kind != dst.kind || src.value_bytes != dst.value_bytes ||
+             src.rank != dst.rank || src.extents[0] != dst.extents[0] ||
+             src.extents[1] != dst.extents[1] ||
+             src.extents[2] != dst.extents[2] )
+            throw std::runtime_error( "Cabana checkpoint member type mismatch" );
+        same_layout = same_layout && ( src.offset == dst.offset );
+    }
+    return same_layout;
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Impl
+} // end namespace Cabana
+
+#endif // end CABANA_CHECKPOINTFORMAT_HPP
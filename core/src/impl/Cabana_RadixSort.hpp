@@ -0,0 +1,230 @@
+/****************************************************************************
+ * Copyright (c) 2018 by the Cabana authors                                 *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef CABANA_RADIXSORT_HPP
+#define CABANA_RADIXSORT_HPP
+
+#include <Cabana_Macros.hpp>
+#include <Cabana_ScratchPool.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <type_traits>
+
+namespace Cabana
+{
+namespace Impl
+{
+//---------------------------------------------------------------------------//
+// Radix sort parameters. Keys are sorted by digits of this many bits and the
+// key range is divided into blocks of this many keys which are counted and
+// scattered by a single thread. Small digits keep the per-thread counts in
+// registers and small blocks expose one thread per 128 keys.
+constexpr int radix_digit_bits = 4;
+constexpr int radix_size = 1 << radix_digit_bits;
+constexpr std::size_t radix_block_size = 128;
+
+//---------------------------------------------------------------------------//
+// Map integer keys to unsigned keys with the same order.
+template<class T, class Enable = void>
+struct RadixKey
+{
+    static constexpr bool is_valid = false;
+};
+
+template<class T>
+struct RadixKey<T,typename std::enable_if<
+                      (std::is_integral<T>::value &&
+                       !std::is_same<T,bool>::value &&
+                       std::is_unsigned<T>::value)>::type>
+{
+    static constexpr bool is_valid = true;
+    using type = T;
+
+    CABANA_INLINE_FUNCTION
+    static type map( const T key )
+    { return key; }
+};
+
+template<class T>
+struct RadixKey<T,typename std::enable_if<
+                      (std::is_integral<T>::value &&
+                       !std::is_same<T,bool>::value &&
+                       std::is_signed<T>::value)>::type>
+{
+    static constexpr bool is_valid = true;
+    using type = typename std::make_unsigned<T>::type;
+
+    // Flip the sign bit such that negative keys order before positive ones.
+    CABANA_INLINE_FUNCTION
+    static type map( const T key )
+    { return type(key) ^ ( type(1) << (8 * sizeof(T) - 1) ); }
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Stable parallel least-significant-digit radix sort of integer keys
+  over a range.
+
+  \param keys The keys to sort.
+
+  \param begin The beginning index of the range to sort.
+
+  \param end The end index of the range to sort.
+
+  \param min_key The smallest key in the range.
+
+  \param max_key The largest key in the range.
+
+  \return The permutation vector such that entry i is the index of the key
+  which sorts at position begin + i.
+
+  Every pass counts the digit of the keys in each block, scans the counts in
+  digit-major order to get the offset of every digit of every block, and
+  scatters each block in order such that the sort is stable. Digits above the
+  highest bit in which the smallest and largest keys differ are the same for
+  all keys and are not sorted.
+*/
+template<class KeyViewType>
+Kokkos::View<typename KeyViewType::memory_space::size_type*,
+             typename KeyViewType::memory_space>
+radixSortPermutation( KeyViewType keys,
+                      const std::size_t begin,
+                      const std::size_t end,
+                      const typename KeyViewType::non_const_value_type min_key,
+                      const typename KeyViewType::non_const_value_type max_key )
+{
+    using kokkos_memory_space = typename KeyViewType::memory_space;
+    using execution_space = typename KeyViewType::execution_space;
+    using size_type = typename kokkos_memory_space::size_type;
+    using key_type = typename KeyViewType::non_const_value_type;
+    using radix_key = RadixKey<key_type>;
+    using ukey_type = typename radix_key::type;
+    using index_view = typename ScratchView<size_type,kokkos_memory_space>::view_type;
+    using key_view = typename ScratchView<ukey_type,kokkos_memory_space>::view_type;
+
+    static_assert( radix_key::is_valid, "Radix sort requires integer keys" );
+
+    std::size_t n = ( end > begin ) ? end - begin : 0;
+    Kokkos::View<size_type*,kokkos_memory_space> permute_vector(
+        Kokkos::ViewAllocateWithoutInitializing("permute_vector"), n );
+    if ( 0 == n ) return permute_vector;
+
+    // Count the digits in which the keys differ.
+    int num_pass = 0;
+    ukey_type diff = radix_key::map( min_key ) ^ radix_key::map( max_key );
+    while ( 0 != diff )
+    {
+        ++num_pass;
+        diff = ukey_type( diff >> radix_digit_bits );
+    }
+
+    // The keys and indices alternate between two buffers each pass. The
+    // indices start in the buffer which makes the last pass write into the
+    // permutation vector.
+    ScratchView<ukey_type,kokkos_memory_space> key_scratch_0(
+        "radix_keys_0", n );
+    ScratchView<ukey_type,kokkos_memory_space> key_scratch_1(
+        "radix_keys_1", n );
+    ScratchView<size_type,kokkos_memory_space> index_scratch(
+        "radix_indices", ( 0 < num_pass ) ? n : 0 );
+    key_view keys_in = key_scratch_0.view();
+    key_view keys_out = key_scratch_1.view();
+    index_view index_in( permute_vector.data(), n );
+    index_view index_out = index_scratch.view();
+    if ( 1 == num_pass % 2 ) std::swap( index_in, index_out );
+
+    auto init_op = KOKKOS_LAMBDA( const std::size_t i )
+                   {
+                       keys_in( i ) = radix_key::map( keys(begin + i) );
+                       index_in( i ) = begin + i;
+                   };
+    Kokkos::parallel_for( "Cabana::radixSort::init",
+                          Kokkos::RangePolicy<execution_space>(0,n),
+                          init_op );
+    Kokkos::fence();
+
+    // Digit counts of each block in digit-major order.
+    std::size_t num_block = ( n + radix_block_size - 1 ) / radix_block_size;
+    ScratchView<size_type,kokkos_memory_space> hist_scratch(
+        "radix_histogram", ( 0 < num_pass ) ? radix_size * num_block : 0 );
+    auto hist = hist_scratch.view();
+
+    for ( int pass = 0; pass < num_pass; ++pass )
+    {
+        int shift = pass * radix_digit_bits;
+
+        auto count_op = KOKKOS_LAMBDA( const std::size_t b )
+        {
+            size_type count[radix_size];
+            for ( int d = 0; d < radix_size; ++d )
+                count[d] = 0;
+            std::size_t i_end = ( (b+1) * radix_block_size < n )
+                                ? (b+1) * radix_block_size : n;
+            for ( std::size_t i = b * radix_block_size; i < i_end; ++i )
+                ++count[ (keys_in(i) >> shift) & (radix_size - 1) ];
+            for ( int d = 0; d < radix_size; ++d )
+                hist( d * num_block + b ) = count[d];
+        };
+        Kokkos::parallel_for( "Cabana::radixSort::count",
+                              Kokkos::RangePolicy<execution_space>(0,num_block),
+                              count_op );
+        Kokkos::fence();
+
+        auto scan_op = KOKKOS_LAMBDA( const std::size_t i,
+                                      size_type& offset,
+                                      const bool final_pass )
+        {
+            size_type count = hist( i );
+            if ( final_pass ) hist( i ) = offset;
+            offset += count;
+        };
+        Kokkos::parallel_scan(
+            "Cabana::radixSort::scan",
+            Kokkos::RangePolicy<execution_space>(0,radix_size*num_block),
+            scan_op );
+        Kokkos::fence();
+
+        auto scatter_op = KOKKOS_LAMBDA( const std::size_t b )
+        {
+            size_type offset[radix_size];
+            for ( int d = 0; d < radix_size; ++d )
+                offset[d] = hist( d * num_block + b );
+            std::size_t i_end = ( (b+1) * radix_block_size < n )
+                                ? (b+1) * radix_block_size : n;
+            for ( std::size_t i = b * radix_block_size; i < i_end; ++i )
+            {
+                size_type o =
+                    offset[ (keys_in(i) >> shift) & (radix_size - 1) ]++;
+                keys_out( o ) = keys_in( i );
+                index_out( o ) = index_in( i );
+            }
+        };
+        Kokkos::parallel_for( "Cabana::radixSort::scatter",
+                              Kokkos::RangePolicy<execution_space>(0,num_block),
+                              scatter_op );
+        Kokkos::fence();
+
+        std::swap( keys_in, keys_out );
+        std::swap( index_in, index_out );
+    }
+
+    return permute_vector;
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Impl
+} // end namespace Cabana
+
+#endif // end CABANA_RADIXSORT_HPP
@@ -11,10 +11,14 @@
 
 #include <Cabana_Types.hpp>
 #include <Cabana_AoSoA.hpp>
+#include <Cabana_DeepCopy.hpp>
 #include <impl/Cabana_Index.hpp>
 
 #include <Kokkos_Core.hpp>
 
+#include <cstdint>
+#include <stdexcept>
+
 #include <gtest/gtest.h>
 
 namespace Test
@@ -443,6 +447,357 @@ void testAccess()
     checkDataMembers( aosoa, fval, dval, ival, dim_1, dim_2, dim_3 );
 }
 
+//---------------------------------------------------------------------------//
+// Test the capacity growth policy of an AoSoA.
+void testGrowth()
+{
+    // Manually set the inner array size.
+    const int vector_length = 16;
+
+    // Declare data types.
+    using DataTypes = Cabana::MemberTypes<double[2],int>;
+
+    // Declare the AoSoA type.
+    using AoSoA_t = Cabana::AoSoA<DataTypes,TEST_MEMSPACE,vector_length>;
+
+    // Create an AoSoA and set the growth factor.
+    AoSoA_t aosoa;
+    EXPECT_EQ( aosoa.growthFactor(), 1.5 );
+    EXPECT_THROW( aosoa.setGrowthFactor(0.5), std::runtime_error );
+    aosoa.setGrowthFactor( 2.0 );
+    EXPECT_EQ( aosoa.growthFactor(), 2.0 );
+
+    // The first allocation is exact.
+    aosoa.resize( 10 );
+    EXPECT_EQ( aosoa.size(), int(10) );
+    EXPECT_EQ( aosoa.capacity(), int(16) );
+
+    // Growing within the capacity does not reallocate.
+    aosoa.resize( 16 );
+    EXPECT_EQ( aosoa.capacity(), int(16) );
+
+    // Growing beyond the capacity doubles it.
+    aosoa.resize( 17 );
+    EXPECT_EQ( aosoa.capacity(), int(32) );
+    aosoa.resize( 33 );
+    EXPECT_EQ( aosoa.capacity(), int(64) );
+
+    // Insert one tuple at a time and check that we reallocate a logarithmic
+    // number of times.
+    int num_realloc = 0;
+    std::size_t last_capacity = aosoa.capacity();
+    for ( int n = 34; n <= 1000; ++n )
+    {
+        aosoa.resize( n );
+        if ( aosoa.capacity() != last_capacity ) ++num_realloc;
+        last_capacity = aosoa.capacity();
+    }
+    EXPECT_EQ( aosoa.size(), int(1000) );
+    EXPECT_EQ( aosoa.capacity(), int(1024) );
+    EXPECT_EQ( num_realloc, 4 );
+
+    // A large resize allocates exactly what is needed.
+    aosoa.resize( 3000 );
+    EXPECT_EQ( aosoa.capacity(), int(3008) );
+
+    // Explicit reservations are not affected by the growth factor.
+    aosoa.reserve( 3010 );
+    EXPECT_EQ( aosoa.capacity(), int(3024) );
+
+    // Assign data.
+    auto slice_0 = aosoa.slice<0>();
+    auto slice_1 = aosoa.slice<1>();
+    for ( std::size_t idx = 0; idx < aosoa.size(); ++idx )
+    {
+        slice_0( idx, 0 ) = idx;
+        slice_0( idx, 1 ) = 2.0 * idx;
+        slice_1( idx ) = idx + 1;
+    }
+
+    // Remove most of the tuples. The memory is not released until we
+    // explicitly shrink the container.
+    aosoa.resize( 21 );
+    EXPECT_EQ( aosoa.capacity(), int(3024) );
+    aosoa.shrinkToFit();
+    EXPECT_EQ( aosoa.size(), int(21) );
+    EXPECT_EQ( aosoa.capacity(), int(32) );
+    EXPECT_EQ( aosoa.numSoA(), int(2) );
+
+    // Check that the data was preserved.
+    slice_0 = aosoa.slice<0>();
+    slice_1 = aosoa.slice<1>();
+    for ( std::size_t idx = 0; idx < aosoa.size(); ++idx )
+    {
+        EXPECT_EQ( slice_0( idx, 0 ), idx );
+        EXPECT_EQ( slice_0( idx, 1 ), 2.0 * idx );
+        EXPECT_EQ( slice_1( idx ), int(idx + 1) );
+    }
+
+    // Shrinking an empty container releases all of its memory.
+    aosoa.resize( 0 );
+    aosoa.shrinkToFit();
+    EXPECT_EQ( aosoa.size(), int(0) );
+    EXPECT_EQ( aosoa.capacity(), int(0) );
+    EXPECT_EQ( aosoa.numSoA(), int(0) );
+
+    // The container can grow again after being emptied.
+    aosoa.resize( 5 );
+    EXPECT_EQ( aosoa.capacity(), int(16) );
+}
+
+//---------------------------------------------------------------------------//
+// Test uninitialized allocation of an AoSoA.
+void testWithoutInitializing()
+{
+    // Manually set the inner array size.
+    const int vector_length = 16;
+
+    // Declare data types.
+    using DataTypes = Cabana::MemberTypes<double[2],int>;
+
+    // Declare the AoSoA type.
+    using AoSoA_t = Cabana::AoSoA<DataTypes,TEST_MEMSPACE,vector_length>;
+
+    // Create an AoSoA without initializing the data.
+    AoSoA_t aosoa( Cabana::WithoutInitializing, 35 );
+    EXPECT_EQ( aosoa.size(), int(35) );
+    EXPECT_EQ( aosoa.capacity(), int(48) );
+    EXPECT_EQ( aosoa.numSoA(), int(3) );
+
+    // Assign data.
+    auto slice_0 = aosoa.slice<0>();
+    auto slice_1 = aosoa.slice<1>();
+    for ( std::size_t idx = 0; idx < aosoa.size(); ++idx )
+    {
+        slice_0( idx, 0 ) = idx;
+        slice_0( idx, 1 ) = 2.0 * idx;
+        slice_1( idx ) = idx + 1;
+    }
+
+    // Check the data.
+    auto check_data = [&]( const std::size_t n ){
+        slice_0 = aosoa.slice<0>();
+        slice_1 = aosoa.slice<1>();
+        for ( std::size_t idx = 0; idx < n; ++idx )
+        {
+            EXPECT_EQ( slice_0( idx, 0 ), idx );
+            EXPECT_EQ( slice_0( idx, 1 ), 2.0 * idx );
+            EXPECT_EQ( slice_1( idx ), int(idx + 1) );
+        }
+    };
+
+    // Reserve more memory. The existing data should be preserved.
+    aosoa.reserve( Cabana::WithoutInitializing, 1000 );
+    EXPECT_EQ( aosoa.size(), int(35) );
+    EXPECT_EQ( aosoa.capacity(), int(1008) );
+    check_data( 35 );
+
+    // Resize within the capacity.
+    aosoa.resize( Cabana::WithoutInitializing, 500 );
+    EXPECT_EQ( aosoa.size(), int(500) );
+    EXPECT_EQ( aosoa.capacity(), int(1008) );
+    check_data( 35 );
+
+    // Resize beyond the capacity.
+    aosoa.resize( 35 );
+    aosoa.resize( Cabana::WithoutInitializing, 2000 );
+    EXPECT_EQ( aosoa.size(), int(2000) );
+    EXPECT_EQ( aosoa.capacity(), int(2000) );
+    EXPECT_EQ( aosoa.numSoA(), int(125) );
+    check_data( 35 );
+
+    // Shrink back down.
+    aosoa.resize( 35 );
+    aosoa.shrinkToFit();
+    EXPECT_EQ( aosoa.capacity(), int(48) );
+    check_data( 35 );
+}
+
+//---------------------------------------------------------------------------//
+void testUnmanaged()
+{
+    // Manually set the inner array size.
+    const int vector_length = 16;
+
+    // Declare data types.
+    using DataTypes = Cabana::MemberTypes<double[2],int>;
+
+    // Declare the AoSoA type.
+    using AoSoA_t = Cabana::AoSoA<DataTypes,TEST_MEMSPACE,vector_length>;
+    using soa_type = typename AoSoA_t::soa_type;
+
+    // Allocate external storage for 3 structs blocked as 16 doubles for each
+    // component of member 0 followed by 16 ints for member 1 and fill it.
+    EXPECT_EQ( sizeof(soa_type), vector_length * (2*sizeof(double) + sizeof(int)) );
+    const std::size_t soa_doubles = sizeof(soa_type) / sizeof(double);
+    Kokkos::View<double*,typename TEST_MEMSPACE::kokkos_memory_space>
+        external( "external", 3 * soa_doubles );
+    for ( std::size_t s = 0; s < 3; ++s )
+    {
+        double* soa = external.data() + s * soa_doubles;
+        int* ints = reinterpret_cast<int*>( soa + 2 * vector_length );
+        for ( int a = 0; a < vector_length; ++a )
+        {
+            std::size_t idx = s * vector_length + a;
+            soa[a] = idx;
+            soa[vector_length + a] = 2.0 * idx;
+            ints[a] = idx + 1;
+        }
+    }
+
+    // Wrap the storage.
+    std::size_t bytes = 3 * sizeof(soa_type);
+    AoSoA_t aosoa( external.data(), 35, bytes, vector_length );
+    EXPECT_FALSE( aosoa.isManaged() );
+    EXPECT_EQ( aosoa.size(), int(35) );
+    EXPECT_EQ( aosoa.capacity(), int(48) );
+    EXPECT_EQ( aosoa.numSoA(), int(3) );
+    EXPECT_EQ( aosoa.ptr(), static_cast<void*>(external.data()) );
+
+    // Read the data through slices and update it.
+    auto slice_0 = aosoa.slice<0>();
+    auto slice_1 = aosoa.slice<1>();
+    for ( std::size_t idx = 0; idx < aosoa.size(); ++idx )
+    {
+        EXPECT_EQ( slice_0( idx, 0 ), idx );
+        EXPECT_EQ( slice_0( idx, 1 ), 2.0 * idx );
+        EXPECT_EQ( slice_1( idx ), int(idx + 1) );
+        slice_0( idx, 1 ) = -1.0 * idx;
+    }
+    for ( std::size_t idx = 0; idx < aosoa.size(); ++idx )
+    {
+        std::size_t s = idx / vector_length;
+        std::size_t a = idx % vector_length;
+        EXPECT_EQ( external( s * soa_doubles + vector_length + a ),
+                   -1.0 * idx );
+    }
+
+    // Resizing within the capacity keeps the storage.
+    aosoa.resize( 48 );
+    aosoa.shrinkToFit();
+    aosoa.resize( 10 );
+    aosoa.shrinkToFit();
+    EXPECT_EQ( aosoa.capacity(), int(48) );
+    EXPECT_EQ( aosoa.ptr(), static_cast<void*>(external.data()) );
+
+    // Growing beyond the capacity is not possible.
+    EXPECT_THROW( aosoa.resize( 49 ), std::runtime_error );
+    EXPECT_THROW( aosoa.reserve( 100 ), std::runtime_error );
+
+    // Layouts which do not match are rejected.
+    EXPECT_THROW( AoSoA_t( external.data(), 10, bytes, 8 ),
+                  std::runtime_error );
+    EXPECT_THROW( AoSoA_t( external.data(), 10, bytes - 8, vector_length ),
+                  std::runtime_error );
+    EXPECT_THROW( AoSoA_t( external.data(), 49, bytes, vector_length ),
+                  std::runtime_error );
+    EXPECT_THROW( AoSoA_t( reinterpret_cast<char*>(external.data()) + 4,
+                           10, 2 * sizeof(soa_type), vector_length ),
+                  std::runtime_error );
+
+    // Deep copy into a managed container.
+    AoSoA_t managed( 10 );
+    Cabana::deep_copy( managed, aosoa );
+    EXPECT_TRUE( managed.isManaged() );
+    auto managed_slice_0 = managed.slice<0>();
+    for ( std::size_t idx = 0; idx < managed.size(); ++idx )
+        EXPECT_EQ( managed_slice_0( idx, 1 ), -1.0 * idx );
+}
+
+//---------------------------------------------------------------------------//
+// Check that every member array of a slice is aligned.
+template<class SliceType>
+void checkSliceAlignment( const SliceType& slice, const std::size_t alignment )
+{
+    for ( std::size_t s = 0; s < slice.numSoA(); ++s )
+        EXPECT_EQ( reinterpret_cast<std::uintptr_t>(
+                       slice.data() + s * slice.stride(0) ) % alignment,
+                   0 );
+}
+
+//---------------------------------------------------------------------------//
+void testAlignment()
+{
+    // Manually set the inner array size.
+    const int vector_length = 4;
+
+    // Declare data types with mixed sizes so the natural layout does not
+    // align the member arrays.
+    using DataTypes = Cabana::MemberTypes<char,double[3],float,int[2]>;
+
+    // Declare the AoSoA types.
+    using AoSoA_t = Cabana::AoSoA<DataTypes,TEST_MEMSPACE,vector_length>;
+    using AlignedAoSoA_t =
+        Cabana::AoSoA<DataTypes,TEST_MEMSPACE,vector_length,64>;
+    using soa_type = typename AlignedAoSoA_t::soa_type;
+
+    // Check the struct padding.
+    EXPECT_EQ( int(AlignedAoSoA_t::alignment), 64 );
+    EXPECT_EQ( sizeof(soa_type) % 64, 0 );
+    EXPECT_EQ( sizeof(soa_type), 64 + 128 + 64 + 64 );
+
+    // Check the layout report.
+    EXPECT_EQ( std::size_t(AlignedAoSoA_t::struct_data_bytes),
+               vector_length * (1 + 24 + 4 + 8) );
+    EXPECT_EQ( std::size_t(AlignedAoSoA_t::struct_padding_bytes),
+               sizeof(soa_type) - vector_length * (1 + 24 + 4 + 8) );
+    EXPECT_EQ( double(AlignedAoSoA_t::bytes_per_tuple),
+               double(sizeof(soa_type)) / vector_length );
+
+    // Without alignment the members are ordered such that only the end of the
+    // struct is padded to the alignment of double.
+    EXPECT_EQ( std::size_t(AoSoA_t::struct_padding_bytes), 4 );
+
+    // Only slices of the aligned AoSoA are marked as aligned.
+    AoSoA_t aosoa( 35 );
+    AlignedAoSoA_t aligned_aosoa( 35 );
+    EXPECT_FALSE( decltype(aosoa.slice<1>())::is_aligned );
+    EXPECT_TRUE( decltype(aligned_aosoa.slice<1>())::is_aligned );
+    EXPECT_TRUE( decltype(aligned_aosoa.slice<1>())::random_access_slice::is_aligned );
+
+    // Check the alignment of every member array.
+    checkSliceAlignment( aligned_aosoa.slice<0>(), 64 );
+    checkSliceAlignment( aligned_aosoa.slice<1>(), 64 );
+    checkSliceAlignment( aligned_aosoa.slice<2>(), 64 );
+    checkSliceAlignment( aligned_aosoa.slice<3>(), 64 );
+
+    // Assign data and copy it to the unaligned layout.
+    auto slice_0 = aligned_aosoa.slice<0>();
+    auto slice_1 = aligned_aosoa.slice<1>();
+    auto slice_2 = aligned_aosoa.slice<2>();
+    auto slice_3 = aligned_aosoa.slice<3>();
+    for ( std::size_t idx = 0; idx < aligned_aosoa.size(); ++idx )
+    {
+        slice_0( idx ) = 'a' + idx % 26;
+        for ( int i = 0; i < 3; ++i )
+            slice_1( idx, i ) = 1.5 * idx + i;
+        slice_2( idx ) = 0.5 * idx;
+        for ( int i = 0; i < 2; ++i )
+            slice_3( idx, i ) = idx + i;
+    }
+    Cabana::deep_copy( aosoa, aligned_aosoa );
+
+    // Check the data.
+    auto copy_0 = aosoa.slice<0>();
+    auto copy_1 = aosoa.slice<1>();
+    auto copy_2 = aosoa.slice<2>();
+    auto copy_3 = aosoa.slice<3>();
+    for ( std::size_t idx = 0; idx < aosoa.size(); ++idx )
+    {
+        EXPECT_EQ( copy_0( idx ), char('a' + idx % 26) );
+        for ( int i = 0; i < 3; ++i )
+            EXPECT_EQ( copy_1( idx, i ), 1.5 * idx + i );
+        EXPECT_EQ( copy_2( idx ), float(0.5 * idx) );
+        for ( int i = 0; i < 2; ++i )
+            EXPECT_EQ( copy_3( idx, i ), int(idx + i) );
+    }
+
+    // The alignment is preserved when the AoSoA grows.
+    aligned_aosoa.resize( 1000 );
+    checkSliceAlignment( aligned_aosoa.slice<1>(), 64 );
+    checkSliceAlignment( aligned_aosoa.slice<3>(), 64 );
+}
+
 //---------------------------------------------------------------------------//
 // RUN TESTS
 //---------------------------------------------------------------------------//
@@ -469,6 +824,30 @@ TEST_F( TEST_CATEGORY, aosoa_access_test )
     testAccess();
 }
 
+//---------------------------------------------------------------------------//
+TEST_F( TEST_CATEGORY, aosoa_growth_test )
+{
+    testGrowth();
+}
+
+//---------------------------------------------------------------------------//
+TEST_F( TEST_CATEGORY, aosoa_without_initializing_test )
+{
+    testWithoutInitializing();
+}
+
+//---------------------------------------------------------------------------//
+TEST_F( TEST_CATEGORY, aosoa_alignment_test )
+{
+    testAlignment();
+}
+
+//---------------------------------------------------------------------------//
+TEST_F( TEST_CATEGORY, aosoa_unmanaged_test )
+{
+    testUnmanaged();
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Test
@@ -0,0 +1,120 @@
+/****************************************************************************
+ * Copyright (c) 2018 by the Cabana authors                                 *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_Append.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <gtest/gtest.h>
+
+namespace Test
+{
+//---------------------------------------------------------------------------//
+// Assign data to an AoSoA based on an id offset.
+template<class AoSoA_t>
+void initData( const AoSoA_t& aosoa, const int id_offset )
+{
+    auto slice_0 = aosoa.template slice<0>();
+    auto slice_1 = aosoa.template slice<1>();
+    for ( std::size_t i = 0; i < aosoa.size(); ++i )
+    {
+        slice_0( i, 0 ) = i + id_offset;
+        slice_0( i, 1 ) = 2.0 * ( i + id_offset );
+        slice_1( i ) = i + id_offset;
+    }
+}
+
+//---------------------------------------------------------------------------//
+// Check that the data in a range of an AoSoA has consecutive ids.
+template<class AoSoA_t>
+void checkData( const AoSoA_t& aosoa,
+                const std::size_t begin,
+                const std::size_t end,
+                const int first_id )
+{
+    auto slice_0 = aosoa.template slice<0>();
+    auto slice_1 = aosoa.template slice<1>();
+    for ( std::size_t i = begin; i < end; ++i )
+    {
+        int id = first_id + i - begin;
+        EXPECT_EQ( slice_0( i, 0 ), id );
+        EXPECT_EQ( slice_0( i, 1 ), 2.0 * id );
+        EXPECT_EQ( slice_1( i ), id );
+    }
+}
+
+//---------------------------------------------------------------------------//
+template<int DstVectorLength, int SrcVectorLength>
+void testAppend( const int num_dst, const int num_src,
+                 const int begin, const int end )
+{
+    // Declare the AoSoA types.
+    using DataTypes = Cabana::MemberTypes<double[2],int>;
+    using DstAoSoA_t =
+        Cabana::AoSoA<DataTypes,TEST_MEMSPACE,DstVectorLength>;
+    using SrcAoSoA_t =
+        Cabana::AoSoA<DataTypes,TEST_MEMSPACE,SrcVectorLength>;
+
+    // Create data.
+    DstAoSoA_t dst( num_dst );
+    initData( dst, 0 );
+    SrcAoSoA_t src( num_src );
+    initData( src, 10000 );
+
+    // Append a range.
+    Cabana::append( dst, src, begin, end );
+    EXPECT_EQ( dst.size(), std::size_t(num_dst + end - begin) );
+    checkData( dst, 0, num_dst, 0 );
+    checkData( dst, num_dst, dst.size(), 10000 + begin );
+
+    // Append everything.
+    std::size_t size = dst.size();
+    Cabana::append( dst, src );
+    EXPECT_EQ( dst.size(), size + num_src );
+    checkData( dst, 0, num_dst, 0 );
+    checkData( dst, num_dst, size, 10000 + begin );
+    checkData( dst, size, dst.size(), 10000 );
+
+    // Check that an invalid range is rejected.
+    EXPECT_THROW( Cabana::append( dst, src, 0, num_src + 1 ),
+                  std::runtime_error );
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST_F( TEST_CATEGORY, append_aligned_test )
+{
+    testAppend<16,16>( 32, 45, 16, 37 );
+}
+
+//---------------------------------------------------------------------------//
+TEST_F( TEST_CATEGORY, append_unaligned_test )
+{
+    testAppend<16,16>( 35, 45, 5, 40 );
+}
+
+//---------------------------------------------------------------------------//
+TEST_F( TEST_CATEGORY, append_different_vector_length_test )
+{
+    testAppend<16,8>( 32, 45, 16, 37 );
+}
+
+//---------------------------------------------------------------------------//
+TEST_F( TEST_CATEGORY, append_empty_test )
+{
+    testAppend<16,16>( 0, 45, 3, 3 );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test
@@ -0,0 +1,120 @@
+/****************************************************************************
+ * Copyright (c) 2018 by the Cabana authors                                 *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_Checkpoint.hpp>
+#include <Cabana_DeepCopy.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace Test
+{
+//---------------------------------------------------------------------------//
+// Fill an AoSoA with data.
+template<class AoSoA_t>
+void fillCheckpointData( AoSoA_t& aosoa )
+{
+    auto slice_0 = aosoa.template slice<0>();
+    auto slice_1 = aosoa.template slice<1>();
+    auto slice_2 = aosoa.template slice<2>();
+    for ( std::size_t n = 0; n < aosoa.size(); ++n )
+    {
+        for ( int i = 0; i < 3; ++i )
+            for ( int j = 0; j < 2; ++j )
+                slice_0( n, i, j ) = n + i + 0.5 * j;
+        slice_1( n ) = n;
+        slice_2( n ) = 0.25 * n;
+    }
+}
+
+//---------------------------------------------------------------------------//
+// Check the data in an AoSoA.
+template<class AoSoA_t>
+void checkCheckpointData( const AoSoA_t& aosoa, const std::size_t num_data )
+{
+    EXPECT_EQ( aosoa.size(), num_data );
+    auto slice_0 = aosoa.template slice<0>();
+    auto slice_1 = aosoa.template slice<1>();
+    auto slice_2 = aosoa.template slice<2>();
+    for ( std::size_t n = 0; n < aosoa.size(); ++n )
+    {
+        for ( int i = 0; i < 3; ++i )
+            for ( int j = 0; j < 2; ++j )
+                EXPECT_EQ( slice_0( n, i, j ), n + i + 0.5 * j );
+        EXPECT_EQ( slice_1( n ), int(n) );
+        EXPECT_EQ( slice_2( n ), float(0.25 * n) );
+    }
+}
+
+//---------------------------------------------------------------------------//
+void testCheckpoint()
+{
+    using DataTypes = Cabana::MemberTypes<double[3][2],int,float>;
+    using AoSoA_t = Cabana::AoSoA<DataTypes,TEST_MEMSPACE,16>;
+    std::string filename = "cabana_checkpoint_test.dat";
+
+    // Write data.
+    std::size_t num_data = 103;
+    AoSoA_t aosoa( num_data );
+    fillCheckpointData( aosoa );
+    Cabana::write( filename, aosoa );
+
+    // Read it back with the same layout.
+    AoSoA_t aosoa_same( 5 );
+    Cabana::read( filename, aosoa_same );
+    checkCheckpointData( aosoa_same, num_data );
+
+    // Read it back with smaller and larger vector lengths and an alignment
+    // such that the structs are re-blocked. Use a small staging size such
+    // that the file is read in several chunks.
+    Cabana::setDeepCopyStagingBytes( 1000 );
+    Cabana::AoSoA<DataTypes,TEST_MEMSPACE,8> aosoa_small;
+    Cabana::read( filename, aosoa_small );
+    checkCheckpointData( aosoa_small, num_data );
+
+    Cabana::AoSoA<DataTypes,TEST_MEMSPACE,32,64> aosoa_large;
+    Cabana::read( filename, aosoa_large );
+    checkCheckpointData( aosoa_large, num_data );
+    Cabana::setDeepCopyStagingBytes( 64 * 1024 * 1024 );
+
+    // Write and read an empty AoSoA.
+    AoSoA_t aosoa_empty;
+    Cabana::write( filename, aosoa_empty );
+    Cabana::read( filename, aosoa_same );
+    EXPECT_EQ( aosoa_same.size(), 0 );
+
+    // Member types must match.
+    Cabana::AoSoA<Cabana::MemberTypes<float[3][2],int,float>,
+                  TEST_MEMSPACE,16> aosoa_float;
+    EXPECT_THROW( Cabana::read( filename, aosoa_float ), std::runtime_error );
+
+    // Missing files are reported.
+    std::remove( filename.c_str() );
+    EXPECT_THROW( Cabana::read( filename, aosoa_same ), std::runtime_error );
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST_F( TEST_CATEGORY, checkpoint_test )
+{
+    testCheckpoint();
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test
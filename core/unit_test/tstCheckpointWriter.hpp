@@ -0,0 +1,122 @@
+/****************************************************************************
+ * Copyright (c) 2018 by the Cabana authors                                 *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_Checkpoint.hpp>
+#include <Cabana_CheckpointWriter.hpp>
+#include <Cabana_DeepCopy.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace Test
+{
+//---------------------------------------------------------------------------//
+// Fill an AoSoA with data.
+template<class AoSoA_t>
+void fillWriterData( AoSoA_t& aosoa )
+{
+    auto slice_0 = aosoa.template slice<0>();
+    auto slice_1 = aosoa.template slice<1>();
+    auto slice_2 = aosoa.template slice<2>();
+    for ( std::size_t n = 0; n < aosoa.size(); ++n )
+    {
+        for ( int i = 0; i < 3; ++i )
+            for ( int j = 0; j < 2; ++j )
+                slice_0( n, i, j ) = n + i + 0.5 * j;
+        slice_1( n ) = n;
+        slice_2( n ) = 0.25 * n;
+    }
+}
+
+//---------------------------------------------------------------------------//
+// Check the data in an AoSoA.
+template<class AoSoA_t>
+void checkWriterData( const AoSoA_t& aosoa, const std::size_t num_data )
+{
+    EXPECT_EQ( aosoa.size(), num_data );
+    auto slice_0 = aosoa.template slice<0>();
+    auto slice_1 = aosoa.template slice<1>();
+    auto slice_2 = aosoa.template slice<2>();
+    for ( std::size_t n = 0; n < aosoa.size(); ++n )
+    {
+        for ( int i = 0; i < 3; ++i )
+            for ( int j = 0; j < 2; ++j )
+                EXPECT_EQ( slice_0( n, i, j ), n + i + 0.5 * j );
+        EXPECT_EQ( slice_1( n ), int(n) );
+        EXPECT_EQ( slice_2( n ), float(0.25 * n) );
+    }
+}
+
+//---------------------------------------------------------------------------//
+void testCheckpointWriter()
+{
+    using DataTypes = Cabana::MemberTypes<double[3][2],int,float>;
+    using AoSoA_t = Cabana::AoSoA<DataTypes,TEST_MEMSPACE,16>;
+    std::string filename_1 = "cabana_checkpoint_writer_test_1.dat";
+    std::string filename_2 = "cabana_checkpoint_writer_test_2.dat";
+
+    std::size_t num_data = 103;
+    AoSoA_t aosoa( num_data );
+    fillWriterData( aosoa );
+
+    // Write with small staging buffers such that the snapshot is split into
+    // several chunks and has to wait for the I/O thread.
+    {
+        Cabana::CheckpointWriter writer( 2, 1000 );
+        writer.write( filename_1, aosoa );
+
+        // The data may be modified once the snapshot is taken.
+        auto slice_1 = aosoa.slice<1>();
+        for ( std::size_t n = 0; n < num_data; ++n )
+            slice_1( n ) = -1;
+
+        // Write a second file with the modified data.
+        writer.write( filename_2, aosoa );
+        writer.wait();
+
+        // Opening a file in a missing directory fails when writing.
+        EXPECT_THROW( writer.write( "missing_directory/checkpoint.dat", aosoa ),
+                      std::runtime_error );
+    }
+
+    // The first file holds the original data.
+    AoSoA_t aosoa_read;
+    Cabana::read( filename_1, aosoa_read );
+    checkWriterData( aosoa_read, num_data );
+
+    // The second file holds the modified data.
+    Cabana::read( filename_2, aosoa_read );
+    EXPECT_EQ( aosoa_read.size(), num_data );
+    auto slice_1 = aosoa_read.slice<1>();
+    for ( std::size_t n = 0; n < num_data; ++n )
+        EXPECT_EQ( slice_1( n ), -1 );
+
+    std::remove( filename_1.c_str() );
+    std::remove( filename_2.c_str() );
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST_F( TEST_CATEGORY, checkpoint_writer_test )
+{
+    testCheckpointWriter();
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test
@@ -11,6 +11,7 @@
 
 #include <Cabana_DeepCopy.hpp>
 #include <Cabana_AoSoA.hpp>
+#include <Cabana_Subview.hpp>
 #include <Cabana_Types.hpp>
 
 #include <gtest/gtest.h>
@@ -57,7 +58,8 @@ void checkDataMembers(
 //---------------------------------------------------------------------------//
 // Perform a deep copy test.
 template<class DstMemorySpace, class SrcMemorySpace,
-         int DstVectorLength, int SrcVectorLength>
+         int DstVectorLength, int SrcVectorLength,
+         int DstAlignment = 0, int SrcAlignment = 0>
 void testDeepCopy()
 {
     // Data dimensions.
@@ -74,8 +76,10 @@ void testDeepCopy()
                             >;
 
     // Declare the AoSoA types.
-    using DstAoSoA_t = Cabana::AoSoA<DataTypes,DstMemorySpace,DstVectorLength>;
-    using SrcAoSoA_t = Cabana::AoSoA<DataTypes,SrcMemorySpace,SrcVectorLength>;
+    using DstAoSoA_t = Cabana::AoSoA<DataTypes,DstMemorySpace,
+                                     DstVectorLength,DstAlignment>;
+    using SrcAoSoA_t = Cabana::AoSoA<DataTypes,SrcMemorySpace,
+                                     SrcVectorLength,SrcAlignment>;
 
     // Create AoSoAs.
     int num_data = 357;
@@ -118,6 +122,243 @@ void testDeepCopy()
     checkDataMembers( dst_aosoa, fval, dval, ival, dim_1, dim_2, dim_3 );
 }
 
+//---------------------------------------------------------------------------//
+// Assign ids to an AoSoA.
+template<class aosoa_type>
+void assignIds( aosoa_type aosoa, const int offset, const int factor )
+{
+    auto slice_0 = aosoa.template slice<0>();
+    auto slice_1 = aosoa.template slice<1>();
+    for ( std::size_t idx = 0; idx < aosoa.size(); ++idx )
+    {
+        int id = offset + factor * idx;
+        for ( int i = 0; i < 3; ++i )
+            slice_0( idx, i ) = id + i;
+        slice_1( idx ) = id;
+    }
+}
+
+//---------------------------------------------------------------------------//
+// Check the ids of an AoSoA over a range.
+template<class aosoa_type>
+void checkIds( aosoa_type aosoa,
+               const std::size_t begin, const std::size_t end,
+               const int offset, const int factor )
+{
+    auto slice_0 = aosoa.template slice<0>();
+    auto slice_1 = aosoa.template slice<1>();
+    for ( std::size_t idx = begin; idx < end; ++idx )
+    {
+        int id = offset + factor * (idx - begin);
+        for ( int i = 0; i < 3; ++i )
+            EXPECT_EQ( slice_0( idx, i ), id + i );
+        EXPECT_EQ( slice_1( idx ), id );
+    }
+}
+
+//---------------------------------------------------------------------------//
+// Perform an asynchronous deep copy test with host work overlapping the
+// copies.
+template<class ExecutionSpace, int DstVectorLength, int SrcVectorLength>
+void testAsyncDeepCopy()
+{
+    // Declare the AoSoA types.
+    using DataTypes = Cabana::MemberTypes<double[3],int>;
+    using DstAoSoA_t =
+        Cabana::AoSoA<DataTypes,Cabana::HostSpace,DstVectorLength>;
+    using SrcAoSoA_t =
+        Cabana::AoSoA<DataTypes,Cabana::HostSpace,SrcVectorLength>;
+
+    // Create AoSoAs.
+    std::size_t num_data_1 = 357;
+    std::size_t num_data_2 = 201;
+    SrcAoSoA_t src_aosoa_1( num_data_1 );
+    SrcAoSoA_t src_aosoa_2( num_data_2 );
+    DstAoSoA_t dst_aosoa_1( num_data_1 );
+    DstAoSoA_t dst_aosoa_2( num_data_2 );
+    assignIds( src_aosoa_1, 0, 1 );
+    assignIds( src_aosoa_2, 100, 2 );
+
+    // Enqueue both copies.
+    ExecutionSpace exec_space;
+    Cabana::deep_copy( exec_space, dst_aosoa_1, src_aosoa_1 );
+    Cabana::deep_copy( exec_space, dst_aosoa_2, src_aosoa_2 );
+
+    // Do some host work while the copies are in flight.
+    auto src_ids = src_aosoa_2.template slice<1>();
+    int id_sum = 0;
+    for ( std::size_t idx = 0; idx < num_data_2; ++idx )
+        id_sum += src_ids( idx );
+    EXPECT_EQ( id_sum, int(100 * num_data_2 + num_data_2 * (num_data_2-1)) );
+
+    // Wait for the copies and check them.
+    Cabana::fence( exec_space );
+    checkIds( dst_aosoa_1, 0, num_data_1, 0, 1 );
+    checkIds( dst_aosoa_2, 0, num_data_2, 100, 2 );
+}
+
+//---------------------------------------------------------------------------//
+// Perform a subview deep copy test.
+template<class DstMemorySpace, class SrcMemorySpace,
+         int DstVectorLength, int SrcVectorLength>
+void testSubviewDeepCopy( const std::size_t dst_begin,
+                          const std::size_t src_begin,
+                          const std::size_t num_copy )
+{
+    // Declare the AoSoA types.
+    using DataTypes = Cabana::MemberTypes<double[3],int>;
+    using DstAoSoA_t = Cabana::AoSoA<DataTypes,DstMemorySpace,DstVectorLength>;
+    using SrcAoSoA_t = Cabana::AoSoA<DataTypes,SrcMemorySpace,SrcVectorLength>;
+
+    // Create AoSoAs.
+    std::size_t num_data = 200;
+    DstAoSoA_t dst_aosoa( num_data );
+    SrcAoSoA_t src_aosoa( num_data );
+    assignIds( dst_aosoa, -1, 0 );
+    assignIds( src_aosoa, 0, 1 );
+
+    // Copy between subviews.
+    Cabana::deep_copy(
+        Cabana::subview( dst_aosoa, dst_begin, dst_begin + num_copy ),
+        Cabana::subview( src_aosoa, src_begin, src_begin + num_copy ) );
+
+    // Check that only the subview range was modified.
+    checkIds( dst_aosoa, 0, dst_begin, -1, 0 );
+    checkIds( dst_aosoa, dst_begin, dst_begin + num_copy, src_begin, 1 );
+    checkIds( dst_aosoa, dst_begin + num_copy, num_data, -1, 0 );
+
+    // Copy from a subview to a whole AoSoA.
+    DstAoSoA_t dst_range( num_copy );
+    Cabana::deep_copy(
+        dst_range,
+        Cabana::subview( src_aosoa, src_begin, src_begin + num_copy ) );
+    checkIds( dst_range, 0, num_copy, src_begin, 1 );
+
+    // Copy from a whole AoSoA to a subview.
+    assignIds( dst_aosoa, -1, 0 );
+    SrcAoSoA_t src_range( num_copy );
+    assignIds( src_range, 7, 2 );
+    Cabana::deep_copy(
+        Cabana::subview( dst_aosoa, dst_begin, dst_begin + num_copy ),
+        src_range );
+    checkIds( dst_aosoa, 0, dst_begin, -1, 0 );
+    checkIds( dst_aosoa, dst_begin, dst_begin + num_copy, 7, 2 );
+    checkIds( dst_aosoa, dst_begin + num_copy, num_data, -1, 0 );
+
+    // Check that subviews of different sizes are rejected.
+    EXPECT_THROW(
+        Cabana::deep_copy( Cabana::subview( dst_aosoa, 0, 10 ),
+                           Cabana::subview( src_aosoa, 0, 11 ) ),
+        std::runtime_error );
+}
+
+//---------------------------------------------------------------------------//
+// Perform a member subset deep copy test.
+template<class DstMemorySpace, class SrcMemorySpace,
+         int DstVectorLength, int SrcVectorLength>
+void testMemberDeepCopy()
+{
+    // Declare the AoSoA types.
+    using DataTypes = Cabana::MemberTypes<double[3],int,float[2][2],double>;
+    using DstAoSoA_t = Cabana::AoSoA<DataTypes,DstMemorySpace,DstVectorLength>;
+    using SrcAoSoA_t = Cabana::AoSoA<DataTypes,SrcMemorySpace,SrcVectorLength>;
+
+    // Create AoSoAs.
+    int num_data = 357;
+    DstAoSoA_t dst_aosoa( num_data );
+    SrcAoSoA_t src_aosoa( num_data );
+
+    // Initialize data.
+    auto init = []( const int id, const int n, const int i, const int j )
+                { return 1.0 * id * ( n + 1 ) + 0.5 * i + 0.25 * j; };
+    auto assign = [&]( const int id, SrcAoSoA_t aosoa ){
+        auto slice_0 = aosoa.template slice<0>();
+        auto slice_1 = aosoa.template slice<1>();
+        auto slice_2 = aosoa.template slice<2>();
+        auto slice_3 = aosoa.template slice<3>();
+        for ( int n = 0; n < num_data; ++n )
+        {
+            for ( int i = 0; i < 3; ++i )
+                slice_0( n, i ) = init( id, n, i, 0 );
+            slice_1( n ) = init( id, n, 0, 0 );
+            for ( int i = 0; i < 2; ++i )
+                for ( int j = 0; j < 2; ++j )
+                    slice_2( n, i, j ) = init( id, n, i, j );
+            slice_3( n ) = init( id, n, 0, 0 );
+        }
+    };
+    auto check = [&]( const int m, const int id, DstAoSoA_t aosoa ){
+        auto slice_0 = aosoa.template slice<0>();
+        auto slice_1 = aosoa.template slice<1>();
+        auto slice_2 = aosoa.template slice<2>();
+        auto slice_3 = aosoa.template slice<3>();
+        for ( int n = 0; n < num_data; ++n )
+        {
+            if ( 0 == m )
+            {
+                for ( int i = 0; i < 3; ++i )
+                    EXPECT_EQ( slice_0( n, i ), init( id, n, i, 0 ) );
+            }
+            if ( 1 == m )
+            {
+                EXPECT_EQ( slice_1( n ), int( init( id, n, 0, 0 ) ) );
+            }
+            if ( 2 == m )
+            {
+                for ( int i = 0; i < 2; ++i )
+                    for ( int j = 0; j < 2; ++j )
+                        EXPECT_EQ( slice_2( n, i, j ),
+                                   float( init( id, n, i, j ) ) );
+            }
+            if ( 3 == m )
+            {
+                EXPECT_EQ( slice_3( n ), init( id, n, 0, 0 ) );
+            }
+        }
+    };
+
+    // Initialize the destination with one set of values and the source with
+    // another.
+    SrcAoSoA_t dst_init( num_data );
+    assign( 1, dst_init );
+    Cabana::deep_copy( dst_aosoa, dst_init );
+    assign( 2, src_aosoa );
+
+    // Copy members 0 and 2.
+    Cabana::deep_copy<0,2>( dst_aosoa, src_aosoa );
+    check( 0, 2, dst_aosoa );
+    check( 1, 1, dst_aosoa );
+    check( 2, 2, dst_aosoa );
+    check( 3, 1, dst_aosoa );
+
+    // Copy member 3 with slices.
+    Cabana::deep_copy( dst_aosoa.template slice<3>(),
+                       src_aosoa.template slice<3>() );
+    check( 1, 1, dst_aosoa );
+    check( 3, 2, dst_aosoa );
+
+    // Copy member 1 alone.
+    Cabana::deep_copy<1>( dst_aosoa, src_aosoa );
+    for ( int m = 0; m < 4; ++m )
+        check( m, 2, dst_aosoa );
+
+    // Copy member 2 from a read-only slice.
+    SrcAoSoA_t src_const( num_data );
+    assign( 3, src_const );
+    Cabana::deep_copy( dst_aosoa.template slice<2>(),
+                       src_const.template constSlice<2>() );
+    check( 0, 2, dst_aosoa );
+    check( 2, 3, dst_aosoa );
+
+    // Check that different sizes are rejected.
+    SrcAoSoA_t src_small( num_data - 1 );
+    EXPECT_THROW( Cabana::deep_copy<0>( dst_aosoa, src_small ),
+                  std::runtime_error );
+    EXPECT_THROW( Cabana::deep_copy( dst_aosoa.template slice<0>(),
+                                     src_small.template slice<0>() ),
+                  std::runtime_error );
+}
+
 //---------------------------------------------------------------------------//
 // TESTS
 //---------------------------------------------------------------------------//
@@ -146,6 +387,75 @@ TEST_F( TEST_CATEGORY, deep_copy_from_host_different_layout_test )
     testDeepCopy<TEST_MEMSPACE,Cabana::HostSpace,16,32>();
 }
 
+//---------------------------------------------------------------------------//
+TEST_F( TEST_CATEGORY, deep_copy_different_alignment_test )
+{
+    testDeepCopy<Cabana::HostSpace,TEST_MEMSPACE,16,32,0,64>();
+    testDeepCopy<TEST_MEMSPACE,Cabana::HostSpace,64,8,0,32>();
+    testDeepCopy<TEST_MEMSPACE,Cabana::HostSpace,16,32,64,16>();
+
+    // Stage a single struct at a time.
+    std::size_t staging_bytes = Cabana::Impl::deepCopyStagingBytes();
+    Cabana::setDeepCopyStagingBytes( 1 );
+    testDeepCopy<Cabana::HostSpace,TEST_MEMSPACE,8,16,0,64>();
+    Cabana::setDeepCopyStagingBytes( staging_bytes );
+}
+
+//---------------------------------------------------------------------------//
+TEST_F( TEST_CATEGORY, deep_copy_chunked_staging_test )
+{
+    // Stage a single struct at a time.
+    std::size_t staging_bytes = Cabana::Impl::deepCopyStagingBytes();
+    Cabana::setDeepCopyStagingBytes( 1 );
+    testDeepCopy<Cabana::HostSpace,TEST_MEMSPACE,16,32>();
+    testDeepCopy<TEST_MEMSPACE,Cabana::HostSpace,64,8>();
+    testSubviewDeepCopy<Cabana::HostSpace,TEST_MEMSPACE,16,16>( 32, 65, 100 );
+    testSubviewDeepCopy<TEST_MEMSPACE,Cabana::HostSpace,16,32>( 17, 5, 150 );
+
+    // Stage a few structs at a time.
+    Cabana::setDeepCopyStagingBytes( 5000 );
+    testDeepCopy<Cabana::HostSpace,TEST_MEMSPACE,16,32>();
+    testSubviewDeepCopy<Cabana::HostSpace,TEST_MEMSPACE,32,8>( 0, 99, 101 );
+    Cabana::setDeepCopyStagingBytes( staging_bytes );
+}
+
+//---------------------------------------------------------------------------//
+TEST_F( TEST_CATEGORY, deep_copy_async_test )
+{
+    testAsyncDeepCopy<TEST_EXECSPACE,16,16>();
+    testAsyncDeepCopy<TEST_EXECSPACE,16,32>();
+    testAsyncDeepCopy<Kokkos::DefaultHostExecutionSpace,32,32>();
+    testAsyncDeepCopy<Kokkos::DefaultHostExecutionSpace,8,64>();
+}
+
+//---------------------------------------------------------------------------//
+TEST_F( TEST_CATEGORY, deep_copy_member_subset_test )
+{
+    testMemberDeepCopy<Cabana::HostSpace,TEST_MEMSPACE,16,16>();
+    testMemberDeepCopy<TEST_MEMSPACE,Cabana::HostSpace,16,16>();
+    testMemberDeepCopy<Cabana::HostSpace,TEST_MEMSPACE,16,32>();
+    testMemberDeepCopy<TEST_MEMSPACE,Cabana::HostSpace,64,8>();
+    testMemberDeepCopy<TEST_MEMSPACE,TEST_MEMSPACE,8,16>();
+}
+
+//---------------------------------------------------------------------------//
+TEST_F( TEST_CATEGORY, deep_copy_subview_aligned_test )
+{
+    testSubviewDeepCopy<Cabana::HostSpace,TEST_MEMSPACE,16,16>( 32, 64, 100 );
+    testSubviewDeepCopy<Cabana::HostSpace,TEST_MEMSPACE,16,16>( 37, 21, 100 );
+    testSubviewDeepCopy<TEST_MEMSPACE,Cabana::HostSpace,16,16>( 35, 3, 10 );
+    testSubviewDeepCopy<TEST_MEMSPACE,Cabana::HostSpace,16,16>( 48, 16, 16 );
+}
+
+//---------------------------------------------------------------------------//
+TEST_F( TEST_CATEGORY, deep_copy_subview_unaligned_test )
+{
+    testSubviewDeepCopy<Cabana::HostSpace,TEST_MEMSPACE,16,16>( 32, 65, 100 );
+    testSubviewDeepCopy<TEST_MEMSPACE,TEST_MEMSPACE,16,16>( 3, 40, 100 );
+    testSubviewDeepCopy<TEST_MEMSPACE,Cabana::HostSpace,16,32>( 17, 5, 150 );
+    testSubviewDeepCopy<Cabana::HostSpace,TEST_MEMSPACE,32,8>( 0, 99, 101 );
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Test
@@ -0,0 +1,175 @@
+/****************************************************************************
+ * Copyright (c) 2018 by the Cabana authors                                 *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_Erase.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace Test
+{
+//---------------------------------------------------------------------------//
+// Create an AoSoA where each tuple stores its original index.
+template<class AoSoA_t>
+AoSoA_t createData( const int num_data )
+{
+    AoSoA_t aosoa( num_data );
+    auto slice_0 = aosoa.template slice<0>();
+    auto slice_1 = aosoa.template slice<1>();
+    for ( int i = 0; i < num_data; ++i )
+    {
+        slice_0( i, 0 ) = i;
+        slice_0( i, 1 ) = 2.0 * i;
+        slice_1( i ) = i;
+    }
+    return aosoa;
+}
+
+//---------------------------------------------------------------------------//
+// Check that the AoSoA contains exactly the expected original indices with
+// consistent data.
+template<class AoSoA_t>
+void checkData( const AoSoA_t& aosoa, const std::vector<int>& expected )
+{
+    EXPECT_EQ( aosoa.size(), expected.size() );
+
+    auto slice_0 = aosoa.template slice<0>();
+    auto slice_1 = aosoa.template slice<1>();
+    std::vector<int> ids( aosoa.size() );
+    for ( std::size_t i = 0; i < aosoa.size(); ++i )
+    {
+        ids[i] = slice_1( i );
+        EXPECT_EQ( slice_0( i, 0 ), ids[i] );
+        EXPECT_EQ( slice_0( i, 1 ), 2.0 * ids[i] );
+    }
+    std::sort( ids.begin(), ids.end() );
+    EXPECT_TRUE( ids == expected );
+}
+
+//---------------------------------------------------------------------------//
+void testErase()
+{
+    // Declare the AoSoA type.
+    using DataTypes = Cabana::MemberTypes<double[2],int>;
+    using AoSoA_t = Cabana::AoSoA<DataTypes,TEST_MEMSPACE>;
+    using MaskView =
+        Kokkos::View<bool*,typename AoSoA_t::memory_space::kokkos_memory_space>;
+
+    // Create data.
+    int num_data = 1003;
+    auto aosoa = createData<AoSoA_t>( num_data );
+    std::size_t capacity = aosoa.capacity();
+
+    // Remove every third tuple.
+    MaskView mask( "mask", num_data );
+    std::vector<int> expected;
+    for ( int i = 0; i < num_data; ++i )
+    {
+        mask( i ) = ( 0 == i % 3 );
+        if ( !mask(i) ) expected.push_back( i );
+    }
+    std::size_t num_removed = Cabana::erase( aosoa, mask );
+    EXPECT_EQ( num_removed, std::size_t(num_data) - expected.size() );
+    EXPECT_EQ( aosoa.capacity(), capacity );
+    checkData( aosoa, expected );
+
+    // Remove a contiguous block such that runs of kept tuples fill the
+    // holes across struct boundaries.
+    auto block_aosoa = createData<AoSoA_t>( num_data );
+    MaskView block_mask( "block_mask", num_data );
+    std::vector<int> block_expected;
+    for ( int i = 0; i < num_data; ++i )
+    {
+        block_mask( i ) = ( 10 <= i && i < 110 );
+        if ( !block_mask(i) ) block_expected.push_back( i );
+    }
+    num_removed = Cabana::erase( block_aosoa, block_mask );
+    EXPECT_EQ( num_removed, std::size_t(100) );
+    checkData( block_aosoa, block_expected );
+
+    // Check that a mask of the wrong size is rejected.
+    EXPECT_THROW( Cabana::erase( aosoa, mask ), std::runtime_error );
+
+    // Remove nothing.
+    MaskView keep_mask( "keep_mask", aosoa.size() );
+    num_removed = Cabana::erase( aosoa, keep_mask );
+    EXPECT_EQ( num_removed, std::size_t(0) );
+    checkData( aosoa, expected );
+
+    // Remove everything.
+    MaskView remove_mask( "remove_mask", aosoa.size() );
+    Kokkos::deep_copy( remove_mask, true );
+    num_removed = Cabana::erase( aosoa, remove_mask );
+    EXPECT_EQ( num_removed, expected.size() );
+    checkData( aosoa, std::vector<int>() );
+}
+
+//---------------------------------------------------------------------------//
+void testRemoveIf()
+{
+    // Declare the AoSoA type.
+    using DataTypes = Cabana::MemberTypes<double[2],int>;
+    using AoSoA_t = Cabana::AoSoA<DataTypes,TEST_MEMSPACE>;
+
+    // Create data.
+    int num_data = 3453;
+    auto aosoa = createData<AoSoA_t>( num_data );
+
+    // Remove the tuples with an odd id or a large first component.
+    auto slice_0 = aosoa.slice<0>();
+    auto slice_1 = aosoa.slice<1>();
+    auto pred = KOKKOS_LAMBDA( const std::size_t i )
+                { return ( 1 == slice_1(i) % 2 ) || ( slice_0(i,0) > 3000.0 ); };
+    std::size_t num_removed = Cabana::remove_if( aosoa, pred );
+
+    // Check the results.
+    std::vector<int> expected;
+    for ( int i = 0; i < num_data; ++i )
+        if ( 0 == i % 2 && i <= 3000 ) expected.push_back( i );
+    EXPECT_EQ( num_removed, std::size_t(num_data) - expected.size() );
+    checkData( aosoa, expected );
+
+    // Remove a run of consecutive tuples in the middle with a predicate on
+    // the tuple data. Kept tuples are moved into the holes of the run.
+    auto run_aosoa = createData<AoSoA_t>( 200 );
+    auto run_slice_1 = run_aosoa.slice<1>();
+    auto run_pred = KOKKOS_LAMBDA( const std::size_t i )
+                    { return ( 10 <= run_slice_1(i) && run_slice_1(i) < 40 ); };
+    num_removed = Cabana::remove_if( run_aosoa, run_pred );
+    std::vector<int> run_expected;
+    for ( int i = 0; i < 200; ++i )
+        if ( i < 10 || 40 <= i ) run_expected.push_back( i );
+    EXPECT_EQ( num_removed, std::size_t(30) );
+    checkData( run_aosoa, run_expected );
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST_F( TEST_CATEGORY, erase_test )
+{
+    testErase();
+}
+
+//---------------------------------------------------------------------------//
+TEST_F( TEST_CATEGORY, remove_if_test )
+{
+    testRemoveIf();
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test
@@ -10,8 +10,13 @@
  ****************************************************************************/
 
 #include <Cabana_AoSoA.hpp>
+#include <Cabana_DeepCopy.hpp>
 #include <Cabana_LinkedCellList.hpp>
 
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 namespace Test
@@ -176,6 +181,114 @@ void testLinkedList()
     }
 }
 
+//---------------------------------------------------------------------------//
+// Check that a list has the same bins as a list built from scratch.
+template<class ListType>
+void checkSameBins( const ListType& list, const ListType& ref_list )
+{
+    EXPECT_EQ( list.rangeBegin(), ref_list.rangeBegin() );
+    EXPECT_EQ( list.rangeEnd(), ref_list.rangeEnd() );
+    for ( int i = 0; i < ref_list.numBin(0); ++i )
+        for ( int j = 0; j < ref_list.numBin(1); ++j )
+            for ( int k = 0; k < ref_list.numBin(2); ++k )
+            {
+                int size = ref_list.binSize(i,j,k);
+                auto offset = ref_list.binOffset(i,j,k);
+                EXPECT_EQ( list.binSize(i,j,k), size );
+                EXPECT_EQ( list.binOffset(i,j,k), offset );
+
+                // Particles in a bin may be in a different order.
+                std::vector<std::size_t> ids;
+                std::vector<std::size_t> ref_ids;
+                for ( int n = 0; n < size; ++n )
+                {
+                    ids.push_back( list.permutation(offset+n) );
+                    ref_ids.push_back( ref_list.permutation(offset+n) );
+                }
+                std::sort( ids.begin(), ids.end() );
+                std::sort( ref_ids.begin(), ref_ids.end() );
+                EXPECT_EQ( ids, ref_ids );
+            }
+}
+
+//---------------------------------------------------------------------------//
+void testLinkedListUpdate()
+{
+    // Put a particle in the center of every cell of a 10x10x10 grid.
+    using DataTypes = Cabana::MemberTypes<double[3]>;
+    using AoSoA_t = Cabana::AoSoA<DataTypes,TEST_MEMSPACE>;
+    using ListType = Cabana::LinkedCellList<typename AoSoA_t::memory_space>;
+    int nx = 10;
+    int num_p = nx * nx * nx;
+    AoSoA_t aosoa( num_p );
+    auto pos = aosoa.slice<0>();
+    for ( int p = 0; p < num_p; ++p )
+    {
+        pos( p, 0 ) = p / (nx*nx) + 0.5;
+        pos( p, 1 ) = (p / nx) % nx + 0.5;
+        pos( p, 2 ) = p % nx + 0.5;
+    }
+    double grid_delta[3] = { 1.0, 1.0, 1.0 };
+    double grid_min[3] = { 0.0, 0.0, 0.0 };
+    double grid_max[3] = { 1.0 * nx, 1.0 * nx, 1.0 * nx };
+
+    // A list which was not built cannot be updated.
+    ListType empty_list;
+    EXPECT_THROW( empty_list.update( pos ), std::runtime_error );
+
+    // Bin a subset of the particles.
+    std::size_t begin = 100;
+    std::size_t end = 900;
+    ListType cell_list( pos, begin, end, grid_delta, grid_min, grid_max );
+
+    // Nothing moved.
+    EXPECT_EQ( cell_list.update( pos ), Cabana::LinkedCellListUpdate::Incremental );
+    checkSameBins(
+        cell_list, ListType( pos, begin, end, grid_delta, grid_min, grid_max ) );
+
+    // Move a few particles in the range to other cells, some of them to the
+    // same cell, and move particles outside of the range. Particles which
+    // move within their cell do not change bins.
+    for ( int n = 0; n < 8; ++n )
+        pos( begin + 97 * n, 0 ) = 9.5 - 0.1 * n;
+    pos( begin + 1, 1 ) = 0.5;
+    pos( begin + 3, 2 ) += 0.3;
+    pos( 0, 0 ) = 5.5;
+    pos( end, 0 ) = 0.5;
+    EXPECT_EQ( cell_list.update( pos ), Cabana::LinkedCellListUpdate::Incremental );
+    checkSameBins(
+        cell_list, ListType( pos, begin, end, grid_delta, grid_min, grid_max ) );
+
+    // Binning data from the update permutes the AoSoA.
+    ListType sorted_list( pos, begin, end, grid_delta, grid_min, grid_max );
+    AoSoA_t sorted( num_p );
+    Cabana::deep_copy( sorted, aosoa );
+    Cabana::permute( sorted_list, sorted );
+    Cabana::permute( cell_list, aosoa );
+    auto sorted_pos = sorted.slice<0>();
+    for ( int p = 0; p < num_p; ++p )
+        for ( int d = 0; d < 3; ++d )
+        {
+            EXPECT_EQ( int(pos(p,d)), int(sorted_pos(p,d)) );
+        }
+
+    // Move more particles than the threshold allows.
+    cell_list.build( pos, begin, end, grid_delta, grid_min, grid_max );
+    for ( std::size_t p = begin; p < end; p += 10 )
+        pos( p, 2 ) = 9.5 - pos( p, 2 );
+    EXPECT_EQ( cell_list.update( pos ), Cabana::LinkedCellListUpdate::Full );
+    checkSameBins(
+        cell_list, ListType( pos, begin, end, grid_delta, grid_min, grid_max ) );
+
+    // A larger threshold updates incrementally.
+    for ( std::size_t p = begin; p < end; p += 10 )
+        pos( p, 2 ) = 9.5 - pos( p, 2 );
+    EXPECT_EQ( cell_list.update( pos, 0.2 ),
+               Cabana::LinkedCellListUpdate::Incremental );
+    checkSameBins(
+        cell_list, ListType( pos, begin, end, grid_delta, grid_min, grid_max ) );
+}
+
 //---------------------------------------------------------------------------//
 // RUN TESTS
 //---------------------------------------------------------------------------//
@@ -184,6 +297,12 @@ TEST_F( TEST_CATEGORY, linked_list_test )
     testLinkedList();
 }
 
+//---------------------------------------------------------------------------//
+TEST_F( TEST_CATEGORY, linked_list_update_test )
+{
+    testLinkedListUpdate();
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Test
@@ -0,0 +1,195 @@
+/****************************************************************************
+ * Copyright (c) 2018 by the Cabana authors                                 *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_Checkpoint.hpp>
+#include <Cabana_ExecutionPolicy.hpp>
+#include <Cabana_MappedFile.hpp>
+#include <Cabana_Parallel.hpp>
+#include <Cabana_Types.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace Test
+{
+class cabana_mapped_file : public ::testing::Test {
+protected:
+  static void SetUpTestCase() {
+  }
+
+  static void TearDownTestCase() {
+  }
+};
+
+//---------------------------------------------------------------------------//
+// Functor to assign values through slices.
+template<class SliceType0, class SliceType1>
+class AssignmentOp
+{
+  public:
+    AssignmentOp( const SliceType0& slice_0, const SliceType1& slice_1 )
+        : _slice_0( slice_0 )
+        , _slice_1( slice_1 )
+    {}
+
+    KOKKOS_INLINE_FUNCTION void operator()( const std::size_t i ) const
+    {
+        for ( int d = 0; d < 3; ++d )
+            _slice_0( i, d ) = i + 0.5 * d;
+        _slice_1( i ) = i;
+    }
+
+  private:
+    SliceType0 _slice_0;
+    SliceType1 _slice_1;
+};
+
+//---------------------------------------------------------------------------//
+// Mapped file test.
+void testMappedFile()
+{
+    const int vector_length = 8;
+    using DataTypes = Cabana::MemberTypes<double[3],int>;
+    using MappedAoSoA_t = Cabana::MappedAoSoA<DataTypes,vector_length>;
+    using AoSoA_t = typename MappedAoSoA_t::aosoa_type;
+
+    std::string filename = "cabana_mapped_file_test.dat";
+    int num_data = 35;
+
+    // Create a file and fill it through the slice API.
+    {
+        MappedAoSoA_t mapped( filename, Cabana::MappedFileMode::Create );
+        EXPECT_EQ( mapped.size(), 0 );
+
+        mapped.resize( num_data );
+        AoSoA_t aosoa = mapped.aosoa();
+        EXPECT_EQ( aosoa.numSoA(), 5 );
+        EXPECT_FALSE( aosoa.isManaged() );
+
+        auto slice_0 = aosoa.slice<0>();
+        auto slice_1 = aosoa.slice<1>();
+        Cabana::Experimental::RangePolicy<
+            vector_length,Kokkos::DefaultHostExecutionSpace>
+            policy( 0, aosoa.size() );
+        Cabana::Experimental::parallel_for(
+            policy, AssignmentOp<decltype(slice_0),decltype(slice_1)>(
+                slice_0, slice_1 ),
+            Cabana::Experimental::StructAndArrayParallelTag() );
+        Kokkos::fence();
+    }
+
+    // The file is a checkpoint.
+    {
+        Cabana::AoSoA<DataTypes,Cabana::HostSpace,16> aosoa;
+        Cabana::read( filename, aosoa );
+        EXPECT_EQ( aosoa.size(), num_data );
+        auto slice_0 = aosoa.slice<0>();
+        auto slice_1 = aosoa.slice<1>();
+        for ( int i = 0; i < num_data; ++i )
+        {
+            for ( int d = 0; d < 3; ++d )
+                EXPECT_EQ( slice_0( i, d ), i + 0.5 * d );
+            EXPECT_EQ( slice_1( i ), i );
+        }
+    }
+
+    // Open the file read-only and check the data. Modifying the data does
+    // not modify the file.
+    {
+        MappedAoSoA_t mapped( filename, Cabana::MappedFileMode::ReadOnly );
+        EXPECT_EQ( mapped.size(), num_data );
+
+        auto slice_0 = mapped.aosoa().slice<0>();
+        auto slice_1 = mapped.aosoa().slice<1>();
+        for ( int i = 0; i < num_data; ++i )
+        {
+            for ( int d = 0; d < 3; ++d )
+                EXPECT_EQ( slice_0( i, d ), i + 0.5 * d );
+            EXPECT_EQ( slice_1( i ), i );
+            slice_1( i ) = -1;
+        }
+
+        // A read-only file cannot grow.
+        EXPECT_THROW( mapped.resize( 10 * num_data ), std::runtime_error );
+    }
+
+    // Open the file for writing, shrink it, and grow it again. New tuples
+    // are zero.
+    {
+        MappedAoSoA_t mapped( filename, Cabana::MappedFileMode::ReadWrite );
+        mapped.resize( 16 );
+        mapped.shrinkToFit();
+        EXPECT_EQ( mapped.aosoa().capacity(), 16 );
+        mapped.resize( num_data );
+
+        auto slice_0 = mapped.aosoa().slice<0>();
+        auto slice_1 = mapped.aosoa().slice<1>();
+        for ( int i = 0; i < num_data; ++i )
+        {
+            for ( int d = 0; d < 3; ++d )
+                EXPECT_EQ( slice_0( i, d ), (i < 16) ? i + 0.5 * d : 0.0 );
+            EXPECT_EQ( slice_1( i ), (i < 16) ? i : 0 );
+        }
+    }
+
+    // Checkpoints written with Cabana::write() are mapped in place.
+    {
+        AoSoA_t aosoa( num_data );
+        auto slice_1 = aosoa.slice<1>();
+        for ( int i = 0; i < num_data; ++i )
+            slice_1( i ) = 2 * i;
+        Cabana::write( filename, aosoa );
+
+        MappedAoSoA_t mapped( filename, Cabana::MappedFileMode::ReadOnly );
+        EXPECT_EQ( mapped.size(), num_data );
+        auto mapped_slice_1 = mapped.aosoa().slice<1>();
+        for ( int i = 0; i < num_data; ++i )
+            EXPECT_EQ( mapped_slice_1( i ), 2 * i );
+    }
+
+    // Checkpoints with other member types or layouts are rejected.
+    EXPECT_THROW(
+        ( Cabana::MappedAoSoA<Cabana::MemberTypes<float[3],int>,vector_length>(
+            filename, Cabana::MappedFileMode::ReadOnly ) ),
+        std::runtime_error );
+    EXPECT_THROW(
+        ( Cabana::MappedAoSoA<DataTypes,16>(
+            filename, Cabana::MappedFileMode::ReadOnly ) ),
+        std::runtime_error );
+
+    // Files which are not checkpoints are rejected.
+    std::FILE* file = std::fopen( filename.c_str(), "wb" );
+    ASSERT_NE( file, nullptr );
+    std::fputs( "not a checkpoint", file );
+    std::fclose( file );
+    EXPECT_THROW( MappedAoSoA_t( filename, Cabana::MappedFileMode::ReadOnly ),
+                  std::runtime_error );
+
+    std::remove( filename.c_str() );
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST_F( cabana_mapped_file, mapped_file_test )
+{
+    testMappedFile();
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test
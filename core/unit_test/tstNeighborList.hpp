@@ -351,6 +351,44 @@ void testVerletListHalf()
     checkHalfNeighborList( nlist, position, test_radius );
 }
 
+//---------------------------------------------------------------------------//
+void testVerletListRebuild()
+{
+    // Create the AoSoA and fill with random particle positions.
+    int num_particle = 1e3;
+    double test_radius = 2.32;
+    double cell_size_ratio = 0.5;
+    double box_min = -5.3 * test_radius;
+    double box_max = 4.7 * test_radius;
+    auto aosoa =
+        createParticles( num_particle, test_radius, box_min, box_max );
+
+    // Create an empty neighbor list and build it.
+    double grid_min[3] = { box_min, box_min, box_min };
+    double grid_max[3] = { box_max, box_max, box_max };
+    Cabana::VerletList<TEST_MEMSPACE,Cabana::FullNeighborTag> nlist;
+    nlist.build( aosoa.slice<0>(), 0, aosoa.size(),
+                 test_radius, cell_size_ratio, grid_min, grid_max );
+    auto position = aosoa.slice<0>();
+    checkFullNeighborList( nlist, position, test_radius );
+
+    // Rebuild the list. The memory of the first build should be reused.
+    auto counts_ptr = nlist._counts.data();
+    auto neighbors_ptr = nlist._neighbors.data();
+    nlist.build( aosoa.slice<0>(), 0, aosoa.size(),
+                 test_radius, cell_size_ratio, grid_min, grid_max );
+    EXPECT_EQ( nlist._counts.data(), counts_ptr );
+    EXPECT_EQ( nlist._neighbors.data(), neighbors_ptr );
+    checkFullNeighborList( nlist, position, test_radius );
+
+    // Rebuild with a smaller radius. The neighbor memory is still reused.
+    double small_radius = 0.5 * test_radius;
+    nlist.build( aosoa.slice<0>(), 0, aosoa.size(),
+                 small_radius, cell_size_ratio, grid_min, grid_max );
+    EXPECT_EQ( nlist._neighbors.data(), neighbors_ptr );
+    checkFullNeighborList( nlist, position, small_radius );
+}
+
 //---------------------------------------------------------------------------//
 void testNeighborParallelFor()
 {
@@ -422,6 +460,12 @@ TEST_F( TEST_CATEGORY, linked_cell_list_half_test )
     testVerletListHalf();
 }
 
+//---------------------------------------------------------------------------//
+TEST_F( TEST_CATEGORY, linked_cell_list_rebuild_test )
+{
+    testVerletListRebuild();
+}
+
 //---------------------------------------------------------------------------//
 TEST_F( TEST_CATEGORY, parallel_for_test )
 {
@@ -13,6 +13,8 @@
 
 #include <Kokkos_Core.hpp>
 
+#include <type_traits>
+
 #include <gtest/gtest.h>
 
 namespace Test
@@ -332,6 +334,320 @@ void atomicAccessTest()
     for ( int i = 0; i < num_data; ++i ) EXPECT_EQ( slice(i), num_data );
 }
 
+//---------------------------------------------------------------------------//
+// Reduced precision storage test.
+void storedMemberTest()
+{
+    // Manually set the inner array size with the test layout.
+    const int vector_length = 8;
+
+    // Declare data types. Member 0 is stored in single precision and computed
+    // with in double precision.
+    using DataTypes =
+        Cabana::MemberTypes<Cabana::Stored<float[3],double>,double>;
+
+    // Create an AoSoA.
+    using AoSoA_t = Cabana::AoSoA<DataTypes,TEST_MEMSPACE,vector_length>;
+    int num_data = 35;
+    AoSoA_t aosoa( num_data );
+
+    // The stored member only takes the space of its storage type.
+    using soa_type = typename AoSoA_t::soa_type;
+    EXPECT_EQ( sizeof(soa_type), vector_length * (3 * sizeof(float) +
+                                                  sizeof(double)) );
+
+    // Slices of the stored member compute in double precision while the raw
+    // data is single precision.
+    auto slice_0 = aosoa.slice<0>();
+    auto slice_1 = aosoa.slice<1>();
+    using slice_type = decltype(slice_0);
+    EXPECT_TRUE( slice_type::is_stored );
+    EXPECT_TRUE( (std::is_same<typename slice_type::value_type,double>::value) );
+    EXPECT_TRUE( (std::is_same<typename slice_type::pointer_type,float*>::value) );
+    EXPECT_FALSE( decltype(slice_1)::is_stored );
+
+    // Compute with the stored member in parallel.
+    auto compute_op =
+        KOKKOS_LAMBDA( const int i )
+        {
+            for ( int d = 0; d < 3; ++d )
+            {
+                slice_0( i, d ) = 1.0 / ( i + d + 3.0 );
+                slice_0( i, d ) *= 2.0;
+                slice_0( i, d ) += 1.0;
+            }
+            slice_1( i ) = slice_0( i, 0 ) + slice_0( i, 1 ) + slice_0( i, 2 );
+        };
+    Kokkos::RangePolicy<TEST_EXECSPACE> exec_policy( 0, num_data );
+    Kokkos::parallel_for( exec_policy, compute_op );
+    Kokkos::fence();
+
+    // Values are rounded to the storage type on every write and read back
+    // in the compute type.
+    for ( int i = 0; i < num_data; ++i )
+    {
+        double sum = 0.0;
+        for ( int d = 0; d < 3; ++d )
+        {
+            float value = static_cast<float>( 1.0 / ( i + d + 3.0 ) );
+            value = static_cast<float>( 2.0 * value );
+            value = static_cast<float>( 1.0 + value );
+            EXPECT_EQ( slice_0( i, d ), double(value) );
+            EXPECT_EQ( slice_0.access( i / vector_length,
+                                       i % vector_length, d ), double(value) );
+            sum += value;
+        }
+        EXPECT_EQ( slice_1( i ), sum );
+    }
+
+    // Tuples access the storage type.
+    auto tuple = aosoa.getTuple( 3 );
+    EXPECT_TRUE( (std::is_same<decltype(tuple.get<0>(0)),float&>::value) );
+    EXPECT_EQ( double(tuple.get<0>(1)), slice_0(3,1) );
+
+    // Copy between stored slices.
+    AoSoA_t aosoa_2( num_data );
+    auto slice_2 = aosoa_2.slice<0>();
+    for ( int i = 0; i < num_data; ++i )
+        for ( int d = 0; d < 3; ++d )
+            slice_2( i, d ) = slice_0( i, d );
+    for ( int i = 0; i < num_data; ++i )
+        for ( int d = 0; d < 3; ++d )
+            EXPECT_EQ( slice_2( i, d ), slice_0( i, d ) );
+}
+
+//---------------------------------------------------------------------------//
+void simdTest()
+{
+    // Manually set the inner array size with the test layout.
+    const int vector_length = 8;
+
+    // Declare data types.
+    using DataTypes = Cabana::MemberTypes<double[3][2],
+                                          Cabana::Stored<float,double>,
+                                          int>;
+
+    // Create an AoSoA with a partially filled last struct and fill the
+    // unused tuples of the last struct.
+    using AoSoA_t = Cabana::AoSoA<DataTypes,TEST_MEMSPACE,vector_length>;
+    int num_data = 35;
+    AoSoA_t aosoa( num_data );
+    aosoa.resize( 40 );
+    auto slice_0 = aosoa.slice<0>();
+    auto slice_1 = aosoa.slice<1>();
+    auto slice_2 = aosoa.slice<2>();
+    for ( int i = 0; i < 40; ++i )
+    {
+        for ( int j = 0; j < 3; ++j )
+            for ( int k = 0; k < 2; ++k )
+                slice_0( i, j, k ) = i + j + 0.5 * k;
+        slice_1( i ) = 0.25 * i;
+        slice_2( i ) = i;
+    }
+    aosoa.resize( num_data );
+    slice_0 = aosoa.slice<0>();
+    slice_1 = aosoa.slice<1>();
+    slice_2 = aosoa.slice<2>();
+
+    // Packs hold the compute type.
+    using pack_0 = typename decltype(slice_0)::simd_type;
+    using pack_1 = typename decltype(slice_1)::simd_type;
+    EXPECT_TRUE( (std::is_same<typename pack_0::value_type,double>::value) );
+    EXPECT_TRUE( (std::is_same<typename pack_1::value_type,double>::value) );
+    EXPECT_EQ( int(pack_0::size), vector_length );
+
+    // Lanes past the end of the slice are zero when loaded.
+    auto last = slice_2.loadSimd( 4 );
+    for ( int a = 0; a < vector_length; ++a )
+        EXPECT_EQ( last[a], (a < 3) ? 32 + a : 0 );
+
+    // Compute with packs over each struct.
+    auto simd_op =
+        KOKKOS_LAMBDA( const int s )
+        {
+            auto scale = slice_1.loadSimd( s );
+            for ( int j = 0; j < 3; ++j )
+            {
+                auto x = slice_0.loadSimd( s, j, 0 );
+                auto y = slice_0.loadSimd( s, j, 1 );
+                slice_0.storeSimd( s, j, 0, 2.0 * x + y * scale );
+                slice_0.storeSimd( s, j, 1, -y );
+            }
+            slice_1.storeSimd( s, scale + 1.0 );
+            slice_2.storeSimd( s, slice_2.loadSimd( s ) * 2 );
+        };
+    Kokkos::RangePolicy<TEST_EXECSPACE> exec_policy( 0, aosoa.numSoA() );
+    Kokkos::parallel_for( exec_policy, simd_op );
+    Kokkos::fence();
+
+    // Check the slice and that the unused tuples are not modified.
+    aosoa.resize( 40 );
+    slice_0 = aosoa.slice<0>();
+    slice_1 = aosoa.slice<1>();
+    slice_2 = aosoa.slice<2>();
+    for ( int i = 0; i < 40; ++i )
+    {
+        bool used = ( i < num_data );
+        double scale = float( 0.25 * i );
+        for ( int j = 0; j < 3; ++j )
+        {
+            double x = i + j;
+            double y = i + j + 0.5;
+            EXPECT_EQ( slice_0( i, j, 0 ), used ? 2.0 * x + y * scale : x );
+            EXPECT_EQ( slice_0( i, j, 1 ), used ? -y : y );
+        }
+        EXPECT_EQ( slice_1( i ), used ? float(scale + 1.0) : scale );
+        EXPECT_EQ( slice_2( i ), used ? 2 * i : i );
+    }
+}
+
+//---------------------------------------------------------------------------//
+void constSliceTest()
+{
+    // Manually set the inner array size with the test layout.
+    const int vector_length = 8;
+
+    // Declare data types.
+    using DataTypes = Cabana::MemberTypes<double[3],
+                                          Cabana::Stored<float,double>,
+                                          double>;
+
+    // Create an AoSoA and fill it.
+    using AoSoA_t = Cabana::AoSoA<DataTypes,TEST_MEMSPACE,vector_length>;
+    int num_data = 35;
+    AoSoA_t aosoa( num_data );
+    auto slice_0 = aosoa.slice<0>();
+    auto slice_1 = aosoa.slice<1>();
+    auto slice_2 = aosoa.slice<2>();
+    for ( int i = 0; i < num_data; ++i )
+    {
+        for ( int d = 0; d < 3; ++d )
+            slice_0( i, d ) = i + 0.5 * d;
+        slice_1( i ) = 0.25 * i;
+    }
+
+    // Get read-only slices.
+    auto const_slice_0 = aosoa.constSlice<0>();
+    auto const_slice_1 = aosoa.constSlice<1>();
+    using const_slice_0_type = decltype(const_slice_0);
+    using const_slice_1_type = decltype(const_slice_1);
+    EXPECT_TRUE( const_slice_0_type::is_read_only );
+    EXPECT_FALSE( decltype(slice_0)::is_read_only );
+    EXPECT_TRUE( (std::is_same<typename const_slice_0_type::pointer_type,
+                  const double*>::value) );
+    EXPECT_TRUE( (std::is_same<typename const_slice_0_type::reference_type,
+                  const double&>::value) );
+    EXPECT_TRUE( (std::is_same<typename const_slice_1_type::reference_type,
+                  double>::value) );
+    EXPECT_FALSE( (std::is_assignable<
+                   typename const_slice_0_type::reference_type,double>::value) );
+    EXPECT_EQ( const_slice_0.size(), aosoa.size() );
+    EXPECT_EQ( const_slice_0.data(), slice_0.data() );
+
+    // Read-only slices are constructed from and assigned slices of the
+    // non-const data type with any memory access type.
+    Cabana::Slice<const double,TEST_MEMSPACE,Cabana::RandomAccessMemory,
+                  vector_length,AoSoA_t::alignment> const_slice_2 =
+        typename decltype(slice_2)::random_access_slice( slice_2 );
+    const_slice_2 = slice_2;
+
+    // Read through the read-only slices, including the member being
+    // written, in parallel.
+    auto sum_op =
+        KOKKOS_LAMBDA( const int i )
+        {
+            slice_2( i ) = const_slice_0( i, 0 ) + const_slice_0( i, 1 ) +
+                           const_slice_0( i, 2 ) + const_slice_1( i );
+            slice_2( i ) += const_slice_2( i );
+            auto pack = const_slice_0.loadSimd( i / vector_length, 0 );
+            slice_2( i ) -= pack[i % vector_length];
+        };
+    Kokkos::RangePolicy<TEST_EXECSPACE> exec_policy( 0, num_data );
+    Kokkos::parallel_for( exec_policy, sum_op );
+    Kokkos::fence();
+
+    // Check the result.
+    for ( int i = 0; i < num_data; ++i )
+        EXPECT_EQ( slice_2( i ), 2 * ( 3.0 * i + 1.5 + 0.25 * i ) - i );
+}
+
+//---------------------------------------------------------------------------//
+void subsliceTest()
+{
+    // Manually set the inner array size with the test layout.
+    const int vector_length = 8;
+
+    // Declare data types.
+    using DataTypes = Cabana::MemberTypes<double[3],
+                                          Cabana::Stored<float[2][3],double>,
+                                          int[2][2][2]>;
+
+    // Create an AoSoA and fill it.
+    using AoSoA_t = Cabana::AoSoA<DataTypes,TEST_MEMSPACE,vector_length>;
+    int num_data = 35;
+    AoSoA_t aosoa( num_data );
+    auto slice_0 = aosoa.slice<0>();
+    auto slice_1 = aosoa.slice<1>();
+    auto slice_2 = aosoa.slice<2>();
+    for ( int i = 0; i < num_data; ++i )
+    {
+        for ( int d = 0; d < 3; ++d )
+            slice_0( i, d ) = i + 0.5 * d;
+        for ( int j = 0; j < 2; ++j )
+            for ( int k = 0; k < 3; ++k )
+                slice_1( i, j, k ) = i + j + 0.25 * k;
+        for ( int j = 0; j < 2; ++j )
+            for ( int k = 0; k < 2; ++k )
+                for ( int l = 0; l < 2; ++l )
+                    slice_2( i, j, k, l ) = i + 4 * j + 2 * k + l;
+    }
+
+    // Get single components.
+    auto x = Cabana::subslice( slice_0, 1 );
+    auto y = Cabana::subslice( slice_1, 1, 2 );
+    auto z = Cabana::subslice( slice_2, 1, 0, 1 );
+    auto x_const = Cabana::subslice( aosoa.constSlice<0>(), 2 );
+    EXPECT_EQ( int(decltype(x)::Rank), 0 );
+    EXPECT_EQ( int(decltype(y)::Rank), 0 );
+    EXPECT_EQ( int(decltype(z)::Rank), 0 );
+    EXPECT_TRUE( decltype(y)::is_stored );
+    EXPECT_TRUE( decltype(x_const)::is_read_only );
+    EXPECT_EQ( x.size(), slice_0.size() );
+    EXPECT_EQ( x.numSoA(), slice_0.numSoA() );
+    EXPECT_EQ( x.stride(0), slice_0.stride(0) );
+
+    // Update the components in parallel.
+    auto update_op =
+        KOKKOS_LAMBDA( const int i )
+        {
+            x( i ) *= 2.0;
+            y( i ) += x_const( i );
+            z( i ) = -z( i );
+        };
+    Kokkos::RangePolicy<TEST_EXECSPACE> exec_policy( 0, num_data );
+    Kokkos::parallel_for( exec_policy, update_op );
+    Kokkos::fence();
+
+    // Check that only the components were modified.
+    for ( int i = 0; i < num_data; ++i )
+    {
+        for ( int d = 0; d < 3; ++d )
+            EXPECT_EQ( slice_0( i, d ), (1 == d) ? 2.0 * (i + 0.5) : i + 0.5 * d );
+        for ( int j = 0; j < 2; ++j )
+            for ( int k = 0; k < 3; ++k )
+                EXPECT_EQ( slice_1( i, j, k ),
+                           (1 == j && 2 == k)
+                           ? double(float(i + 1.5 + i + 1.0))
+                           : double(float(i + j + 0.25 * k)) );
+        for ( int j = 0; j < 2; ++j )
+            for ( int k = 0; k < 2; ++k )
+                for ( int l = 0; l < 2; ++l )
+                    EXPECT_EQ( slice_2( i, j, k, l ),
+                               (1 == j && 0 == k && 1 == l ? -1 : 1) *
+                               (i + 4 * j + 2 * k + l) );
+    }
+}
+
 //---------------------------------------------------------------------------//
 // RUN TESTS
 //---------------------------------------------------------------------------//
@@ -352,6 +668,30 @@ TEST_F( TEST_CATEGORY, atomic_access_test )
     atomicAccessTest();
 }
 
+//---------------------------------------------------------------------------//
+TEST_F( TEST_CATEGORY, stored_member_test )
+{
+    storedMemberTest();
+}
+
+//---------------------------------------------------------------------------//
+TEST_F( TEST_CATEGORY, simd_test )
+{
+    simdTest();
+}
+
+//---------------------------------------------------------------------------//
+TEST_F( TEST_CATEGORY, const_slice_test )
+{
+    constSliceTest();
+}
+
+//---------------------------------------------------------------------------//
+TEST_F( TEST_CATEGORY, subslice_test )
+{
+    subsliceTest();
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Test
@@ -80,6 +80,55 @@ void testSoA()
     EXPECT_EQ( soa.get<5>(2,1,1,1), v2 );
 }
 
+//---------------------------------------------------------------------------//
+// SoA layout ordering test.
+void testSoALayout()
+{
+    // Declare member types in an order which would require padding between
+    // the members.
+    using member_types = Cabana::MemberTypes<char,
+                                             double,
+                                             short,
+                                             float,
+                                             int[3],
+                                             double[2]>;
+    using soa_type = Cabana::SoA<member_types,1>;
+
+    // The members are ordered by alignment so the only padding is at the end
+    // of the struct.
+    EXPECT_EQ( std::size_t(soa_type::data_bytes), 43 );
+    EXPECT_EQ( sizeof(soa_type), 48 );
+
+    // The members with the largest alignment come first.
+    soa_type soa;
+    char* base = reinterpret_cast<char*>( &soa );
+    EXPECT_EQ( static_cast<char*>(soa.ptr<1>()), base );
+    EXPECT_EQ( static_cast<char*>(soa.ptr<5>()), base + 8 );
+    EXPECT_EQ( static_cast<char*>(soa.ptr<3>()), base + 24 );
+    EXPECT_EQ( static_cast<char*>(soa.ptr<4>()), base + 28 );
+    EXPECT_EQ( static_cast<char*>(soa.ptr<2>()), base + 40 );
+    EXPECT_EQ( static_cast<char*>(soa.ptr<0>()), base + 42 );
+
+    // Members are still accessed by their original index.
+    soa.get<0>( 0 ) = 'c';
+    soa.get<1>( 0 ) = 1.1;
+    soa.get<2>( 0 ) = 2;
+    soa.get<3>( 0 ) = 3.3;
+    for ( int i = 0; i < 3; ++i )
+        soa.get<4>( 0, i ) = 4 + i;
+    for ( int i = 0; i < 2; ++i )
+        soa.get<5>( 0, i ) = 5.5 + i;
+
+    EXPECT_EQ( soa.get<0>(0), 'c' );
+    EXPECT_EQ( soa.get<1>(0), 1.1 );
+    EXPECT_EQ( soa.get<2>(0), 2 );
+    EXPECT_EQ( soa.get<3>(0), float(3.3) );
+    for ( int i = 0; i < 3; ++i )
+        EXPECT_EQ( soa.get<4>(0,i), 4 + i );
+    for ( int i = 0; i < 2; ++i )
+        EXPECT_EQ( soa.get<5>(0,i), 5.5 + i );
+}
+
 //---------------------------------------------------------------------------//
 // TESTS
 //---------------------------------------------------------------------------//
@@ -88,6 +137,12 @@ TEST_F( cabana_soa, soa_test )
     testSoA();
 }
 
+//---------------------------------------------------------------------------//
+TEST_F( cabana_soa, soa_layout_test )
+{
+    testSoALayout();
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Test
@@ -12,6 +12,11 @@
 #include <Cabana_AoSoA.hpp>
 #include <Cabana_Sort.hpp>
 
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 namespace Test
@@ -216,6 +221,74 @@ void testSortBySlice()
     }
 }
 
+//---------------------------------------------------------------------------//
+void testSortBySubslice()
+{
+    // Data dimensions.
+    const int dim_1 = 3;
+    const int dim_2 = 2;
+
+    // Declare data types.
+    using DataTypes = Cabana::MemberTypes<float[dim_1],
+                                          int,
+                                          double[dim_1][dim_2]>;
+
+    // Declare the AoSoA type.
+    using AoSoA_t = Cabana::AoSoA<DataTypes,TEST_MEMSPACE>;
+
+    // Create an AoSoA.
+    int num_data = 3453;
+    AoSoA_t aosoa( num_data );
+
+    // Create the AoSoA data. Create the data in reverse order so we can see
+    // that it is sorted.
+    auto v0 = aosoa.slice<0>();
+    auto v1 = aosoa.slice<1>();
+    auto v2 = aosoa.slice<2>();
+    for ( std::size_t p = 0; p < aosoa.size(); ++p )
+    {
+        int reverse_index = aosoa.size() - p - 1;
+
+        for ( int i = 0; i < dim_1; ++i )
+            v0( p, i ) = reverse_index + i;
+
+        v1( p ) = reverse_index;
+
+        for ( int i = 0; i < dim_1; ++i )
+            for ( int j = 0; j < dim_2; ++j )
+                v2( p, i, j ) = reverse_index + i + j;
+    }
+
+    // Sort the aosoa by single components of the multidimensional members.
+    auto binning_data =
+        Cabana::sortByKey( Cabana::subslice( aosoa.constSlice<2>(), 2, 1 ) );
+    Cabana::permute( binning_data, aosoa );
+
+    // Check the result of the sort.
+    for ( std::size_t p = 0; p < aosoa.size(); ++p )
+    {
+        int reverse_index = aosoa.size() - p - 1;
+
+        for ( int i = 0; i < dim_1; ++i )
+            EXPECT_EQ( v0( p, i ), p + i );
+
+        EXPECT_EQ( v1( p ), p );
+
+        for ( int i = 0; i < dim_1; ++i )
+            for ( int j = 0; j < dim_2; ++j )
+                EXPECT_EQ( v2( p, i, j ), p + i + j );
+
+        EXPECT_EQ( binning_data.permutation(p), (unsigned) reverse_index );
+    }
+
+    // Bin by the first component of the rank-1 member.
+    auto bin_data =
+        Cabana::binByKey( Cabana::subslice( v0, 0 ), num_data - 1 );
+    EXPECT_EQ( bin_data.numBin(), num_data );
+    for ( std::size_t p = 0; p < aosoa.size(); ++p )
+        EXPECT_EQ( bin_data.binSize(p), 1 );
+}
+
 //---------------------------------------------------------------------------//
 void testSortBySliceDataOnly()
 {
@@ -409,6 +482,357 @@ void testBinBySliceDataOnly()
     }
 }
 
+//---------------------------------------------------------------------------//
+void testScratchReuse()
+{
+    // Declare the AoSoA type.
+    using DataTypes = Cabana::MemberTypes<double[3],int>;
+    using AoSoA_t = Cabana::AoSoA<DataTypes,TEST_MEMSPACE>;
+
+    using pool_type = Cabana::Impl::ScratchPool<
+        typename TEST_MEMSPACE::kokkos_memory_space>;
+
+    // Start from an empty pool and reserve scratch memory for the keys only.
+    // The nested temporaries of the sort do not fit.
+    Cabana::releaseScratch<TEST_MEMSPACE>();
+    int num_data = 1234;
+    Cabana::reserveScratch<TEST_MEMSPACE>( num_data * sizeof(int) );
+    EXPECT_TRUE( 0 < Cabana::scratchCapacity<TEST_MEMSPACE>() );
+
+    // Sort several times with data in reverse order. After the first step the
+    // scratch memory should not grow and all temporaries should be drawn
+    // from it.
+    std::size_t capacity = 0;
+    std::size_t num_fallback = 0;
+    AoSoA_t aosoa( num_data );
+    auto v0 = aosoa.slice<0>();
+    auto v1 = aosoa.slice<1>();
+    for ( int step = 0; step < 3; ++step )
+    {
+        for ( std::size_t p = 0; p < aosoa.size(); ++p )
+        {
+            int reverse_index = aosoa.size() - p - 1;
+            for ( int i = 0; i < 3; ++i )
+                v0( p, i ) = reverse_index + i;
+            v1( p ) = reverse_index;
+        }
+
+        auto binning_data = Cabana::sortByKey( aosoa.slice<1>() );
+        Cabana::permute( binning_data, aosoa );
+        if ( 0 == step )
+        {
+            EXPECT_TRUE( 0 < pool_type::instance().numFallback() );
+            capacity = Cabana::scratchCapacity<TEST_MEMSPACE>();
+            num_fallback = pool_type::instance().numFallback();
+        }
+        else
+        {
+            EXPECT_EQ( Cabana::scratchCapacity<TEST_MEMSPACE>(), capacity );
+            EXPECT_EQ( pool_type::instance().numFallback(), num_fallback );
+        }
+
+        for ( std::size_t p = 0; p < aosoa.size(); ++p )
+        {
+            for ( int i = 0; i < 3; ++i )
+                EXPECT_EQ( v0( p, i ), p + i );
+            EXPECT_EQ( v1( p ), p );
+        }
+    }
+
+    // Release the scratch memory.
+    Cabana::releaseScratch<TEST_MEMSPACE>();
+    EXPECT_EQ( Cabana::scratchCapacity<TEST_MEMSPACE>(), 0 );
+}
+
+//---------------------------------------------------------------------------//
+void testSortByKeyRange()
+{
+    // Declare the AoSoA type with a vector length that does not divide the
+    // range bounds.
+    using DataTypes = Cabana::MemberTypes<float[3],int>;
+    using AoSoA_t = Cabana::AoSoA<DataTypes,TEST_MEMSPACE,8>;
+
+    // Create an AoSoA.
+    int num_data = 123;
+    AoSoA_t aosoa( num_data );
+
+    // Create a Kokkos view for the keys.
+    using KeyViewType =
+        Kokkos::View<int*,typename AoSoA_t::memory_space::kokkos_memory_space>;
+    KeyViewType keys( "keys", num_data );
+
+    // Create the data in reverse order.
+    auto v0 = aosoa.slice<0>();
+    auto v1 = aosoa.slice<1>();
+    for ( int p = 0; p < num_data; ++p )
+    {
+        int reverse_index = num_data - p - 1;
+        for ( int i = 0; i < 3; ++i )
+            v0( p, i ) = reverse_index + i;
+        v1( p ) = reverse_index;
+        keys( p ) = reverse_index;
+    }
+
+    // Sort a range which starts and ends in the middle of a struct.
+    std::size_t begin = 5;
+    std::size_t end = num_data - 7;
+    auto binning_data = Cabana::sortByKey( keys, begin, end );
+    Cabana::permute( binning_data, aosoa );
+
+    // Check that the range is sorted and the rest is untouched.
+    for ( int p = 0; p < num_data; ++p )
+    {
+        int expected = num_data - p - 1;
+        if ( begin <= std::size_t(p) && std::size_t(p) < end )
+            expected = num_data - end + ( p - begin );
+        for ( int i = 0; i < 3; ++i )
+            EXPECT_EQ( v0( p, i ), expected + i );
+        EXPECT_EQ( v1( p ), expected );
+    }
+}
+
+//---------------------------------------------------------------------------//
+void testPermuteByMember()
+{
+    // Declare the AoSoA type with a vector length that does not divide the
+    // range bounds.
+    using DataTypes = Cabana::MemberTypes<float[3],
+                                          int,
+                                          Cabana::Stored<float,double>,
+                                          double[2][2]>;
+    using AoSoA_t = Cabana::AoSoA<DataTypes,TEST_MEMSPACE,8>;
+
+    // Create an AoSoA.
+    int num_data = 123;
+    AoSoA_t aosoa( num_data );
+
+    // Create a Kokkos view for the keys.
+    using KeyViewType =
+        Kokkos::View<int*,typename AoSoA_t::memory_space::kokkos_memory_space>;
+    KeyViewType keys( "keys", num_data );
+
+    // Create the data in reverse order.
+    auto v0 = aosoa.slice<0>();
+    auto v1 = aosoa.slice<1>();
+    auto v2 = aosoa.slice<2>();
+    auto v3 = aosoa.slice<3>();
+    for ( int p = 0; p < num_data; ++p )
+    {
+        int reverse_index = num_data - p - 1;
+        for ( int i = 0; i < 3; ++i )
+            v0( p, i ) = reverse_index + i;
+        v1( p ) = reverse_index;
+        v2( p ) = 0.5 * reverse_index;
+        for ( int i = 0; i < 2; ++i )
+            for ( int j = 0; j < 2; ++j )
+                v3( p, i, j ) = reverse_index + 2 * i + j;
+        keys( p ) = reverse_index;
+    }
+
+    // Sort a range which starts and ends in the middle of a struct and
+    // permute the members one at a time.
+    std::size_t begin = 5;
+    std::size_t end = num_data - 7;
+    auto binning_data = Cabana::sortByKey( keys, begin, end );
+    Cabana::permute( Cabana::PermuteByMember, binning_data, aosoa );
+
+    // Check that the range is sorted and the rest is untouched.
+    for ( int p = 0; p < num_data; ++p )
+    {
+        int expected = num_data - p - 1;
+        if ( begin <= std::size_t(p) && std::size_t(p) < end )
+            expected = num_data - end + ( p - begin );
+        for ( int i = 0; i < 3; ++i )
+            EXPECT_EQ( v0( p, i ), expected + i );
+        EXPECT_EQ( v1( p ), expected );
+        EXPECT_EQ( v2( p ), 0.5 * expected );
+        for ( int i = 0; i < 2; ++i )
+            for ( int j = 0; j < 2; ++j )
+                EXPECT_EQ( v3( p, i, j ), expected + 2 * i + j );
+    }
+}
+
+//---------------------------------------------------------------------------//
+void testPermuteSubset()
+{
+    // Declare the AoSoA types.
+    using DataTypes = Cabana::MemberTypes<float[3],int,double>;
+    using AoSoA_t = Cabana::AoSoA<DataTypes,TEST_MEMSPACE,8>;
+    using AuxDataTypes = Cabana::MemberTypes<long,double[2]>;
+    using AuxAoSoA_t = Cabana::AoSoA<AuxDataTypes,TEST_MEMSPACE,16>;
+
+    // Create the AoSoAs.
+    int num_data = 123;
+    AoSoA_t aosoa( num_data );
+    AuxAoSoA_t aux( num_data );
+
+    // Create the data in reverse order.
+    auto v0 = aosoa.slice<0>();
+    auto v1 = aosoa.slice<1>();
+    auto v2 = aosoa.slice<2>();
+    auto a0 = aux.slice<0>();
+    auto a1 = aux.slice<1>();
+    for ( int p = 0; p < num_data; ++p )
+    {
+        int reverse_index = num_data - p - 1;
+        for ( int i = 0; i < 3; ++i )
+            v0( p, i ) = reverse_index + i;
+        v1( p ) = reverse_index;
+        v2( p ) = 0.5 * reverse_index;
+        a0( p ) = 2 * reverse_index;
+        for ( int i = 0; i < 2; ++i )
+            a1( p, i ) = reverse_index - i;
+    }
+
+    // Sort a range by member 1 and only permute members 0 and 2 of the
+    // AoSoA and member 1 of the auxiliary AoSoA.
+    std::size_t begin = 5;
+    std::size_t end = num_data - 7;
+    auto binning_data = Cabana::sortByKey( v1, begin, end );
+    Cabana::permute<2,0>( binning_data, aosoa );
+    Cabana::permute( binning_data, a1 );
+
+    // Check that only the permuted members are sorted.
+    for ( int p = 0; p < num_data; ++p )
+    {
+        int reverse_index = num_data - p - 1;
+        int expected = reverse_index;
+        if ( begin <= std::size_t(p) && std::size_t(p) < end )
+            expected = num_data - end + ( p - begin );
+        for ( int i = 0; i < 3; ++i )
+            EXPECT_EQ( v0( p, i ), expected + i );
+        EXPECT_EQ( v1( p ), reverse_index );
+        EXPECT_EQ( v2( p ), 0.5 * expected );
+        EXPECT_EQ( a0( p ), 2 * reverse_index );
+        for ( int i = 0; i < 2; ++i )
+            EXPECT_EQ( a1( p, i ), expected - i );
+    }
+}
+
+//---------------------------------------------------------------------------//
+// Check a radix sort of keys over a range against a stable sort.
+template<class KeyType>
+void checkRadixSort( const std::vector<KeyType>& host_keys,
+                     const std::size_t begin,
+                     const std::size_t end,
+                     const bool compare_bin_sort = true )
+{
+    using KeyViewType =
+        Kokkos::View<KeyType*,typename TEST_MEMSPACE::kokkos_memory_space>;
+    KeyViewType keys( "keys", host_keys.size() );
+    for ( std::size_t i = 0; i < host_keys.size(); ++i )
+        keys( i ) = host_keys[i];
+
+    auto binning_data = Cabana::sortByKey( keys, begin, end );
+    EXPECT_EQ( binning_data.rangeBegin(), begin );
+    EXPECT_EQ( binning_data.rangeEnd(), end );
+
+    // The bins partition the sorted keys in order.
+    std::size_t offset = 0;
+    for ( int b = 0; b < binning_data.numBin(); ++b )
+    {
+        EXPECT_EQ( binning_data.binOffset(b), offset );
+        offset += binning_data.binSize(b);
+        if ( 0 < binning_data.binSize(b) && 0 < binning_data.binOffset(b) )
+        {
+            std::size_t first = binning_data.binOffset(b);
+            EXPECT_LE( host_keys[binning_data.permutation(first - 1)],
+                       host_keys[binning_data.permutation(first)] );
+        }
+    }
+    EXPECT_EQ( offset, end - begin );
+
+    // Equal keys are in the first bin. Otherwise the bins are those of a
+    // bin sort over the same range.
+    bool equal_keys = std::all_of(
+        host_keys.begin() + begin, host_keys.begin() + end,
+        [&]( const KeyType k ){ return k == host_keys[begin]; } );
+    if ( equal_keys && end > begin )
+    {
+        EXPECT_EQ( binning_data.binSize(0), int(end - begin) );
+    }
+    else if ( compare_bin_sort && !equal_keys )
+    {
+        auto bin_data = Cabana::binByKey( keys, (end - begin) / 2, begin, end );
+        EXPECT_EQ( binning_data.numBin(), bin_data.numBin() );
+        for ( int b = 0; b < bin_data.numBin(); ++b )
+        {
+            EXPECT_EQ( binning_data.binSize(b), bin_data.binSize(b) );
+            EXPECT_EQ( binning_data.binOffset(b), bin_data.binOffset(b) );
+        }
+    }
+
+    std::vector<std::size_t> expected( end - begin );
+    for ( std::size_t i = begin; i < end; ++i )
+        expected[i - begin] = i;
+    std::stable_sort( expected.begin(), expected.end(),
+                      [&]( const std::size_t a, const std::size_t b )
+                      { return host_keys[a] < host_keys[b]; } );
+    for ( std::size_t i = begin; i < end; ++i )
+        EXPECT_EQ( binning_data.permutation(i - begin), expected[i - begin] );
+}
+
+//---------------------------------------------------------------------------//
+void testRadixSort()
+{
+    // Skewed 64-bit keys such as global ids with many duplicates and
+    // negative values. The number of keys spans several blocks.
+    std::size_t num_data = 10007;
+    std::vector<long> long_keys( num_data );
+    for ( std::size_t i = 0; i < num_data; ++i )
+    {
+        long hash = ( i * 2654435761ul ) % 1000;
+        long_keys[i] = ( 0 == i % 3 )
+                       ? ( hash << 40 ) - ( 1l << 50 )
+                       : hash % 7;
+    }
+    checkRadixSort( long_keys, 0, num_data );
+    checkRadixSort( long_keys, 13, num_data - 29 );
+
+    // Small unsigned keys need a single pass.
+    std::vector<unsigned char> char_keys( num_data );
+    for ( std::size_t i = 0; i < num_data; ++i )
+        char_keys[i] = ( i * 37 ) % 251;
+    checkRadixSort( char_keys, 0, num_data );
+
+    // Equal keys keep their order and empty ranges are allowed.
+    std::vector<int> equal_keys( 100, 5 );
+    checkRadixSort( equal_keys, 0, 100 );
+    checkRadixSort( equal_keys, 50, 50 );
+
+    // 64-bit keys spread evenly over the whole signed range such as hashes
+    // with the sign bit set. The key differences overflow the key type so
+    // the bin sort is not a valid reference but the keys must still spread
+    // over the bins.
+    std::size_t num_spread = 1000;
+    std::uint64_t step =
+        std::numeric_limits<std::uint64_t>::max() / ( num_spread - 1 );
+    std::vector<std::int64_t> spread_keys( num_spread );
+    for ( std::size_t i = 0; i < num_spread; ++i )
+    {
+        std::size_t j = ( i * 37 ) % num_spread;
+        spread_keys[i] = static_cast<std::int64_t>(
+            std::uint64_t(std::numeric_limits<std::int64_t>::min()) + j * step );
+    }
+    spread_keys[ ( (num_spread - 1) * 37 ) % num_spread ] =
+        std::numeric_limits<std::int64_t>::max();
+    checkRadixSort( spread_keys, 0, num_spread, false );
+
+    using KeyViewType =
+        Kokkos::View<std::int64_t*,typename TEST_MEMSPACE::kokkos_memory_space>;
+    KeyViewType keys( "keys", num_spread );
+    for ( std::size_t i = 0; i < num_spread; ++i )
+        keys( i ) = spread_keys[i];
+    auto binning_data = Cabana::sortByKey( keys );
+    EXPECT_EQ( binning_data.numBin(), int(num_spread / 2 + 1) );
+    for ( int b = 0; b < binning_data.numBin(); ++b )
+        EXPECT_LE( binning_data.binSize(b), 3 );
+    EXPECT_EQ( keys( binning_data.permutation(0) ),
+               std::numeric_limits<std::int64_t>::min() );
+    EXPECT_EQ( keys( binning_data.permutation(num_spread - 1) ),
+               std::numeric_limits<std::int64_t>::max() );
+}
+
 //---------------------------------------------------------------------------//
 // RUN TESTS
 //---------------------------------------------------------------------------//
@@ -417,6 +841,30 @@ TEST_F( TEST_CATEGORY, sort_by_key_test )
     testSortByKey();
 }
 
+//---------------------------------------------------------------------------//
+TEST_F( TEST_CATEGORY, sort_by_key_range_test )
+{
+    testSortByKeyRange();
+}
+
+//---------------------------------------------------------------------------//
+TEST_F( TEST_CATEGORY, permute_by_member_test )
+{
+    testPermuteByMember();
+}
+
+//---------------------------------------------------------------------------//
+TEST_F( TEST_CATEGORY, permute_subset_test )
+{
+    testPermuteSubset();
+}
+
+//---------------------------------------------------------------------------//
+TEST_F( TEST_CATEGORY, radix_sort_test )
+{
+    testRadixSort();
+}
+
 //---------------------------------------------------------------------------//
 TEST_F( TEST_CATEGORY, bin_by_key_test )
 {
@@ -429,6 +877,12 @@ TEST_F( TEST_CATEGORY, sort_by_member_test )
     testSortBySlice();
 }
 
+//---------------------------------------------------------------------------//
+TEST_F( TEST_CATEGORY, sort_by_subslice_test )
+{
+    testSortBySubslice();
+}
+
 //---------------------------------------------------------------------------//
 TEST_F( TEST_CATEGORY, sort_by_member_data_only_test )
 {
@@ -447,6 +901,12 @@ TEST_F( TEST_CATEGORY, bin_by_member_data_only_test )
     testBinBySliceDataOnly();
 }
 
+//---------------------------------------------------------------------------//
+TEST_F( TEST_CATEGORY, scratch_reuse_test )
+{
+    testScratchReuse();
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Test
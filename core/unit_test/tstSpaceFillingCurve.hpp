@@ -0,0 +1,160 @@
+/****************************************************************************
+ * Copyright (c) 2018 by the Cabana authors                                 *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_Sort.hpp>
+#include <Cabana_SpaceFillingCurve.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace Test
+{
+//---------------------------------------------------------------------------//
+void testCurveKeys()
+{
+    // Morton keys interleave the coordinate bits.
+    EXPECT_EQ( Cabana::Impl::mortonKey(1,0,0), 4u );
+    EXPECT_EQ( Cabana::Impl::mortonKey(0,1,0), 2u );
+    EXPECT_EQ( Cabana::Impl::mortonKey(0,0,1), 1u );
+    EXPECT_EQ( Cabana::Impl::mortonKey(3,3,3), 63u );
+    std::uint32_t max_c = ( 1u << Cabana::Impl::curve_bits ) - 1;
+    EXPECT_EQ( Cabana::Impl::mortonKey(max_c,max_c,max_c),
+               ( std::uint64_t(1) << 63 ) - 1 );
+
+    // The Hilbert curve starts at the origin such that the cells of a small
+    // cube at the origin have the first keys, and consecutive cells along
+    // the curve are face neighbors.
+    const int n = 8;
+    std::vector<std::uint64_t> keys;
+    std::vector<int> cells;
+    for ( int i = 0; i < n; ++i )
+        for ( int j = 0; j < n; ++j )
+            for ( int k = 0; k < n; ++k )
+            {
+                keys.push_back( Cabana::Impl::hilbertKey(i,j,k) );
+                cells.push_back( (i * n + j) * n + k );
+            }
+    std::vector<int> order( keys.size() );
+    for ( std::size_t c = 0; c < order.size(); ++c )
+        order[c] = c;
+    std::sort( order.begin(), order.end(),
+               [&]( const int a, const int b ){ return keys[a] < keys[b]; } );
+    for ( std::size_t c = 0; c < order.size(); ++c )
+        EXPECT_EQ( keys[order[c]], c );
+    for ( std::size_t c = 1; c < order.size(); ++c )
+    {
+        int a = cells[order[c-1]];
+        int b = cells[order[c]];
+        int dist = std::abs( a / (n*n) - b / (n*n) ) +
+                   std::abs( (a / n) % n - (b / n) % n ) +
+                   std::abs( a % n - b % n );
+        EXPECT_EQ( dist, 1 );
+    }
+}
+
+//---------------------------------------------------------------------------//
+void testSortByCurve( const Cabana::SpaceFillingCurve curve )
+{
+    // Create particles at the centers of a lattice of cells in reverse
+    // order.
+    const int n = 4;
+    using DataTypes = Cabana::MemberTypes<double[3],int>;
+    using AoSoA_t = Cabana::AoSoA<DataTypes,TEST_MEMSPACE>;
+    int num_data = n * n * n;
+    AoSoA_t aosoa( num_data );
+    auto x = aosoa.slice<0>();
+    auto id = aosoa.slice<1>();
+    for ( int p = 0; p < num_data; ++p )
+    {
+        int cell = num_data - p - 1;
+        x( p, 0 ) = cell / (n*n) + 0.5;
+        x( p, 1 ) = (cell / n) % n + 0.5;
+        x( p, 2 ) = cell % n + 0.5;
+        id( p ) = cell;
+    }
+
+    // Sort along the curve.
+    double grid_min[3] = { 0.0, 0.0, 0.0 };
+    double grid_max[3] = { 1.0 * n, 1.0 * n, 1.0 * n };
+    auto binning_data =
+        Cabana::sortBySpaceFillingCurve( x, grid_min, grid_max, curve );
+    Cabana::permute( binning_data, aosoa );
+
+    // Check that the keys of the lattice cells increase along the AoSoA and
+    // that the particles moved with their positions.
+    std::uint32_t scale = ( 1u << Cabana::Impl::curve_bits ) / n;
+    auto key = [&]( const int cell )
+               {
+                   std::uint32_t i = ( cell / (n*n) ) * scale + scale / 2;
+                   std::uint32_t j = ( (cell / n) % n ) * scale + scale / 2;
+                   std::uint32_t k = ( cell % n ) * scale + scale / 2;
+                   return ( Cabana::SpaceFillingCurve::Hilbert == curve )
+                       ? Cabana::Impl::hilbertKey( i, j, k )
+                       : Cabana::Impl::mortonKey( i, j, k );
+               };
+    for ( int p = 0; p < num_data; ++p )
+    {
+        int cell = id( p );
+        EXPECT_EQ( x( p, 0 ), cell / (n*n) + 0.5 );
+        EXPECT_EQ( x( p, 1 ), (cell / n) % n + 0.5 );
+        EXPECT_EQ( x( p, 2 ), cell % n + 0.5 );
+        if ( 0 < p )
+        {
+            EXPECT_LT( key( id(p-1) ), key( cell ) );
+        }
+    }
+
+    // Particles outside of the box are clamped to it and a subset of the
+    // range may be sorted.
+    x( 0, 0 ) = -10.0;
+    x( num_data - 1, 2 ) = 10.0;
+    binning_data = Cabana::sortBySpaceFillingCurve(
+        x, 1, num_data - 1, grid_min, grid_max, curve );
+    EXPECT_EQ( binning_data.rangeBegin(), 1u );
+    EXPECT_EQ( binning_data.rangeEnd(), std::size_t(num_data - 1) );
+    Cabana::permute( binning_data, aosoa );
+    for ( int p = 2; p < num_data - 1; ++p )
+        EXPECT_LT( key( id(p-1) ), key( id(p) ) );
+    binning_data = Cabana::sortBySpaceFillingCurve(
+        x, grid_min, grid_max, curve );
+    EXPECT_EQ( binning_data.permutation(0), 0u );
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST_F( TEST_CATEGORY, curve_keys_test )
+{
+    testCurveKeys();
+}
+
+//---------------------------------------------------------------------------//
+TEST_F( TEST_CATEGORY, sort_by_morton_test )
+{
+    testSortByCurve( Cabana::SpaceFillingCurve::Morton );
+}
+
+//---------------------------------------------------------------------------//
+TEST_F( TEST_CATEGORY, sort_by_hilbert_test )
+{
+    testSortByCurve( Cabana::SpaceFillingCurve::Hilbert );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test
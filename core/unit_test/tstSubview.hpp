@@ -0,0 +1,111 @@
+/****************************************************************************
+ * Copyright (c) 2018 by the Cabana authors                                 *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_Subview.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <gtest/gtest.h>
+
+namespace Test
+{
+//---------------------------------------------------------------------------//
+void testSubview()
+{
+    // Manually set the inner array size.
+    const int vector_length = 16;
+
+    // Declare the AoSoA type.
+    using DataTypes = Cabana::MemberTypes<double[3][2],int>;
+    using AoSoA_t = Cabana::AoSoA<DataTypes,TEST_MEMSPACE,vector_length>;
+
+    // Create data.
+    int num_data = 100;
+    AoSoA_t aosoa( num_data );
+    auto slice_0 = aosoa.slice<0>();
+    auto slice_1 = aosoa.slice<1>();
+    for ( int n = 0; n < num_data; ++n )
+    {
+        for ( int i = 0; i < 3; ++i )
+            for ( int j = 0; j < 2; ++j )
+                slice_0( n, i, j ) = n + i + j;
+        slice_1( n ) = n;
+    }
+
+    // Create a subview of the owned tuples.
+    auto owned = Cabana::subview( aosoa, 32, 75 );
+    EXPECT_TRUE( Cabana::is_aosoa_subview<decltype(owned)>::value );
+    EXPECT_FALSE( Cabana::is_aosoa<decltype(owned)>::value );
+    EXPECT_EQ( owned.size(), std::size_t(43) );
+    EXPECT_EQ( owned.rangeBegin(), std::size_t(32) );
+    EXPECT_EQ( owned.rangeEnd(), std::size_t(75) );
+
+    // Check the slices.
+    auto sv_slice_0 = owned.slice<0>();
+    auto sv_slice_1 = owned.slice<1>();
+    EXPECT_EQ( sv_slice_0.size(), std::size_t(43) );
+    EXPECT_EQ( sv_slice_0.numSoA(), std::size_t(3) );
+    for ( std::size_t n = 0; n < owned.size(); ++n )
+    {
+        for ( int i = 0; i < 3; ++i )
+            for ( int j = 0; j < 2; ++j )
+                EXPECT_EQ( sv_slice_0( n, i, j ), n + 32 + i + j );
+        EXPECT_EQ( sv_slice_1( n ), int(n + 32) );
+    }
+
+    // Writing through the subview modifies the AoSoA.
+    sv_slice_1( 0 ) = -1;
+    EXPECT_EQ( slice_1( 32 ), -1 );
+    sv_slice_1( 0 ) = 32;
+
+    // Check tuple access with local indices.
+    auto tuple = owned.getTuple( 3 );
+    EXPECT_EQ( tuple.get<1>(), 35 );
+    tuple.get<1>() = 1000;
+    owned.setTuple( 3, tuple );
+    EXPECT_EQ( slice_1( 35 ), 1000 );
+    EXPECT_EQ( slice_1( 34 ), 34 );
+    EXPECT_EQ( slice_1( 36 ), 36 );
+
+    // Subviews which begin inside a struct give offset slices.
+    auto ghost = Cabana::subview( aosoa, 75, 100 );
+    EXPECT_EQ( ghost.getTuple( 0 ).get<1>(), 75 );
+    auto ghost_slice_0 = ghost.slice<0>();
+    auto ghost_slice_1 = ghost.slice<1>();
+    EXPECT_EQ( ghost_slice_1.size(), std::size_t(25) );
+    EXPECT_EQ( ghost_slice_1.numSoA(), std::size_t(3) );
+    for ( std::size_t n = 0; n < ghost.size(); ++n )
+    {
+        for ( int i = 0; i < 3; ++i )
+            for ( int j = 0; j < 2; ++j )
+                EXPECT_EQ( ghost_slice_0( n, i, j ), n + 75 + i + j );
+        EXPECT_EQ( ghost_slice_1( n ), int(n + 75) );
+    }
+    ghost_slice_1( 5 ) = -1;
+    EXPECT_EQ( slice_1( 80 ), -1 );
+
+    // Invalid ranges are rejected.
+    EXPECT_THROW( Cabana::subview( aosoa, 50, 101 ), std::runtime_error );
+    EXPECT_THROW( Cabana::subview( aosoa, 50, 40 ), std::runtime_error );
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST_F( TEST_CATEGORY, subview_test )
+{
+    testSubview();
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test